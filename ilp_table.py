@@ -10,12 +10,14 @@ data["bandwidth"] = data["bandwidth"] * 1e-9
 data["flops"] = data["flops"].apply(lambda x: round(x, 3))
 data["bandwidth"] = data["bandwidth"].apply(lambda x: round(x, 3))
 
-code_order = ["S", "V", "B", "BP", "BO1", "BO2", "BO3", "BOf"]
+code_order = ["S", "V", "V512", "B", "BP", "BO1", "BO2", "BO3", "BOf", "BH", "IP", "CO", "AT", "B_F16", "B_BF16", "B_F32", "B_F64", "B_I32", "B_I64", "B_C128"]
 data["code"] = pd.Categorical(data["code"], categories=code_order, ordered=True)
-data = data.sort_values(by=["code", "n"])
+data = data.sort_values(by=["code", "m", "n"])
+data["size"] = data.apply(lambda x: str(x["n"]) if x["m"] == x["n"] else f"{x['m']}x{x['n']}", axis=1)
+data["size"] = pd.Categorical(data["size"], categories=data.sort_values(by=["m", "n"])["size"].unique(), ordered=True)
 
-pivot_flops = data.pivot(index="code", columns="n", values="flops")
-pivot_bandwidth = data.pivot(index="code", columns="n", values="bandwidth")
+pivot_flops = data.pivot(index="code", columns="size", values="flops")
+pivot_bandwidth = data.pivot(index="code", columns="size", values="bandwidth")
 
 print("FLOPS (GFLOPS) FROM EXPERIMENTS")
 print(tabulate(pivot_flops, headers="keys", tablefmt="grid", floatfmt=".3f"))
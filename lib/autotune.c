@@ -0,0 +1,153 @@
+#include <immintrin.h>
+#include <math.h>
+#include <omp.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "functions.h"
+#include "tuning.h"
+
+// Maximum time in seconds spent on every candidate, the repetitions stop early when it is exceeded
+#ifndef TUNING_TIME
+#define TUNING_TIME 0.1
+#endif
+
+// Kernels that can be tuned, in the same order of their names
+#define KERNELS 4
+const char* kernels[KERNELS] = {"checkSym", "matTranspose", "checkSymOMP", "matTransposeOMP"};
+
+// Average time of kernel k with profile p over at most rep repetitions
+double measure(int k, const double* M, double* T, size_t m, size_t n, const struct Profile* p, int rep) {
+    volatile bool symmetric;  // keeps the symmetry checks from being removed
+    double start = omp_get_wtime(), elapsed = 0;
+    int i = 0;
+
+    while (i < rep && elapsed < TUNING_TIME) {
+        switch (k) {
+            case 0: symmetric = checkSymTuned(M, m, n, p); break;
+            case 1: matTransposeTuned(M, T, m, n, p); break;
+            case 2: symmetric = checkSymTunedOMP(M, m, n, p); break;
+            case 3: matTransposeTunedOMP(M, T, m, n, p); break;
+        }
+        i++;
+        elapsed = omp_get_wtime() - start;
+    }
+    (void)symmetric;
+
+    return elapsed / i;
+}
+
+// Measures the candidate profile of kernel k and keeps it as the best one if it is faster
+void tryCandidate(int k, const double* M, double* T, size_t m, size_t n, int rep, const struct Profile* candidate, struct Profile* best, double* best_time) {
+    double time = measure(k, M, T, m, n, candidate, rep);
+    if (time < *best_time) {
+        *best_time = time;
+        *best = *candidate;
+    }
+}
+
+// Searches the best profile of kernel k one parameter group at a time, starting from the default profile:
+// block size and loop order, then prefetch distance and, for the OpenMP kernels, schedule kind and chunk size
+struct Profile tune(int k, const double* M, double* T, size_t m, size_t n, int rep) {
+    const size_t blocks[] = {8, 16, 32, 64, 128, 256};
+    const int prefetches[] = {0, 1, 2, 4};
+    const int chunks[] = {0, 1, 2, 4, 8};
+
+    struct Profile best = defaultProfile(), base, candidate;
+    double best_time = measure(k, M, T, m, n, &best, rep);
+
+    base = best;
+    for (int b = 0; b < 6; b++) {
+        for (int order = ROW_ORDER; order <= COLUMN_ORDER; order++) {
+            candidate = base;
+            candidate.block = blocks[b];
+            candidate.order = order;
+            tryCandidate(k, M, T, m, n, rep, &candidate, &best, &best_time);
+        }
+    }
+
+    base = best;
+    for (int d = 0; d < 4; d++) {
+        candidate = base;
+        candidate.prefetch = prefetches[d];
+        tryCandidate(k, M, T, m, n, rep, &candidate, &best, &best_time);
+    }
+
+    if (k >= 2) {  // OpenMP kernels
+        base = best;
+        for (int schedule = omp_sched_static; schedule <= omp_sched_guided; schedule++) {
+            for (int c = 0; c < 5; c++) {
+                candidate = base;
+                candidate.schedule = schedule;
+                candidate.chunk = chunks[c];
+                tryCandidate(k, M, T, m, n, rep, &candidate, &best, &best_time);
+            }
+        }
+    }
+
+    printf("%s: %.9f seconds, ", kernels[k], best_time);
+    printProfile(kernels[k], &best, 0);
+
+    return best;
+}
+
+// The attribute is necessary to avoid the compiler optimization on the repetitions loops
+int __attribute__((optimize("O0"))) main(int argc, char** argv) {
+#ifdef _OPENMP
+    printf("Compiled with OpenMP %d.%02d\n", _OPENMP / 100, _OPENMP % 100);
+#else
+    printf("Error: compile with -fopenmp flag");
+#endif
+
+    size_t m = 0;
+    size_t n = 0;
+    int rep = 0;
+    int threads = 0;
+    if (parseArguments(argc, argv, &m, &n, &rep, &threads) == -1) {
+        return 1;
+    }
+
+    char model[64];
+    cpuModel(model, sizeof(model));
+
+    printf("Matrix dimensions: %zu x %zu (size class %d)\n", m, n, sizeClass(m, n));
+    printf("Repetitions: %d\n", rep);
+    printf("CPU model: %s\n\n", model);
+
+    // Variables declaration
+    struct Profile profile;  // loaded or tuned profile
+    double* M;               // input matrix
+    double* T;               // transposed matrix
+
+    // Matrices allocation
+    if (initMatrices(&M, &T, m, n) == -1) {
+        printf("Error in allocating matrices!\n\n");
+        return -1;
+    }
+
+    // The OpenMP kernels are tuned with the passed threads, all the available ones when 0
+    omp_set_num_threads(threads == 0 ? omp_get_num_procs() : threads);
+
+    // Tuning of the kernels whose size class was not tuned yet on this CPU
+    for (int k = 0; k < KERNELS; k++) {
+        if (loadProfile(kernels[k], m, n, &profile) == 0) {
+            printProfile(kernels[k], &profile, 0);
+            continue;
+        }
+
+        profile = tune(k, M, T, m, n, rep);
+
+        if (saveProfile(kernels[k], m, n, &profile) == -1) {
+            printf("Error in saving the profile!\n\n");
+        }
+    }
+    printf("\n");
+
+    // Matrices deallocation
+    free(M);
+    free(T);
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,77 @@
+#include <immintrin.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "functions.h"
+#include "tuning.h"
+
+#define CODE "AT"
+
+// The attribute is necessary to avoid the compiler optimization on the repetitions loops
+int __attribute__((optimize("O0"))) main(int argc, char** argv) {
+    size_t m = 0;
+    size_t n = 0;
+    int rep = 0;
+    if (parseArguments(argc, argv, &m, &n, &rep, NULL) == -1) {
+        return 1;
+    }
+
+    printf("Matrix dimensions: %zu x %zu\n\n", m, n);
+    printf("Repetitions: %d\n\n", rep);
+
+    // Profiles loading, produced by autotune.o for this CPU
+    struct Profile check_profile, transpose_profile;
+    printProfile("checkSym", &check_profile, loadProfile("checkSym", m, n, &check_profile));
+    printProfile("matTranspose", &transpose_profile, loadProfile("matTranspose", m, n, &transpose_profile));
+    printf("\n");
+
+    // Variables declaration
+    struct timespec s1, s2, e1, e2;   // start, end times
+    double t1, t2, flops, bandwidth;  // execution times and performance metrics
+    bool symmetric = false;           // symmetry check
+    double* M;                        // input matrix
+    double* T;                        // transposed matrix
+
+    // Matrices allocation
+    if (initMatrices(&M, &T, m, n) == -1) {
+        printf("Error in allocating matrices!\n\n");
+        return -1;
+    }
+
+    // Execution
+    clock_gettime(CLOCK_MONOTONIC, &s1);
+    for (int i = 0; i < rep; i++) symmetric = checkSymTuned(M, m, n, &check_profile);
+    clock_gettime(CLOCK_MONOTONIC, &e1);
+
+    clock_gettime(CLOCK_MONOTONIC, &s2);
+    for (int i = 0; i < rep; i++) matTransposeTuned(M, T, m, n, &transpose_profile);
+    clock_gettime(CLOCK_MONOTONIC, &e2);
+    // --------------------------------
+
+    // Results printing and saving
+    t1 = elapsedTime(s1, e1) / rep;
+    t2 = elapsedTime(s2, e2) / rep;
+
+    const size_t size = check_profile.block < n ? check_profile.block : n;
+    flops = m == n ? (double)n * (n + size) / 2 / t1 : 0;  // rectangular matrices are not checked
+    bandwidth = (double)(2 * m * n * sizeof(double)) / t2;
+
+    printf("Sequential execution: symmetry: %s\n", symmetric ? "true" : "false");
+    printf("checkSym:\t%.9f seconds\t%10.4g GFLOPS\n", t1, flops * 1e-9);
+    printf("matTranspose:\t%.9f seconds\t%10.4g GB/s\n\n", t2, bandwidth * 1e-9);
+
+    testResults(M, T, m, n);
+
+    if (saveResultsILP(CODE, m, n, flops, bandwidth) == -1) {
+        printf("Error in saving results!\n\n");
+    }
+
+    // Matrices deallocation
+    free(M);
+    free(T);
+
+    return 0;
+}
\ No newline at end of file
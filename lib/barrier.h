@@ -0,0 +1,44 @@
+#ifndef BARRIER_H
+#define BARRIER_H
+
+#include <immintrin.h>
+#include <sched.h>
+#include <stdatomic.h>
+
+// Spins of a waiting thread before yielding the core, so that oversubscribed teams (more threads than cores) still
+// make progress. It can be tuned at compile time with -DSPIN_LIMIT=...
+#ifndef SPIN_LIMIT
+#define SPIN_LIMIT 64
+#endif
+
+// Sense-reversing spin barrier for the threads of a parallel region: the last thread to arrive resets the counter and
+// flips the global sense, the others spin on it. Every thread keeps its own sense, initially 0.
+struct SpinBarrier {
+    atomic_int waiting;  // threads still to arrive in the current phase
+    atomic_int sense;    // flipped at the end of every phase
+    int threads;
+};
+
+void initSpinBarrier(struct SpinBarrier* barrier, int threads) {
+    atomic_init(&barrier->waiting, threads);
+    atomic_init(&barrier->sense, 0);
+    barrier->threads = threads;
+}
+
+// Waits for all the threads, with the memory ordering of a barrier: the writes before it are visible after it
+static inline void spinBarrier(struct SpinBarrier* barrier, int* local_sense) {
+    *local_sense = !*local_sense;
+
+    if (atomic_fetch_sub_explicit(&barrier->waiting, 1, memory_order_acq_rel) == 1) {
+        atomic_store_explicit(&barrier->waiting, barrier->threads, memory_order_relaxed);
+        atomic_store_explicit(&barrier->sense, *local_sense, memory_order_release);
+        return;
+    }
+
+    for (int spins = 0; atomic_load_explicit(&barrier->sense, memory_order_acquire) != *local_sense; spins++) {
+        if (spins < SPIN_LIMIT) _mm_pause();
+        else sched_yield();
+    }
+}
+
+#endif
\ No newline at end of file
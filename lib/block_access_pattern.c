@@ -15,22 +15,28 @@
 #define CODE "BO3"
 #elif defined(Ofast)
 #define CODE "BOf"
+#elif defined(HUGE_PAGES)
+#define CODE "BH"
 #else
 #define CODE "B"
 #endif
 
 #define BLOCK_SIZE 32
 
-bool checkSymImp(const double* M, int n) {
-    const int size = BLOCK_SIZE < n ? BLOCK_SIZE : n;
+bool checkSymImp(const double* M, size_t m, size_t n) {
+    if (m != n) return false;  // only square matrices can be symmetric
+    const size_t size = BLOCK_SIZE < n ? BLOCK_SIZE : n;
+    const size_t blocks = blockCount(n, size);
     bool check = true;
 
-    for (int rb = 0; rb < n / size; rb++) {                  // row blocks indexing
-        for (int cb = 0; cb <= rb; cb++) {                   // column blocks indexing
+    for (size_t rb = 0; rb < blocks; rb++) {                 // row blocks indexing
+        const size_t rows = blockLength(n, rb, size);        // edge blocks can be smaller
+        for (size_t cb = 0; cb <= rb; cb++) {                // column blocks indexing
+            const size_t cols = blockLength(n, cb, size);
             const double* first = M + (rb * n + cb) * size;  // block matrix of lower triangular part
             const double* last = M + (cb * n + rb) * size;   // block matrix of higher triangular part
-            for (int i = 0; i < size; i++) {                 // symmetry check
-                for (int j = 0; j < size; j++) {
+            for (size_t i = 0; i < rows; i++) {              // symmetry check
+                for (size_t j = 0; j < cols; j++) {
                     if (fabs(first[i * n + j] - last[j * n + i]) > EPSILON) {
                         check = false;
                     }
@@ -42,16 +48,18 @@ bool checkSymImp(const double* M, int n) {
     return check;
 }
 
-void matTransposeImp(const double* M, double* T, int n) {
-    const int size = BLOCK_SIZE < n ? BLOCK_SIZE : n;
+void matTransposeImp(const double* M, double* T, size_t m, size_t n) {
+    const size_t size = BLOCK_SIZE < n ? BLOCK_SIZE : n;
 
-    for (int rb = 0; rb < n / size; rb++) {                   // row blocks indexing
-        for (int cb = 0; cb < n / size; cb++) {               // column blocks indexing
+    for (size_t rb = 0; rb < blockCount(m, size); rb++) {     // row blocks indexing
+        const size_t rows = blockLength(m, rb, size);         // edge blocks can be smaller
+        for (size_t cb = 0; cb < blockCount(n, size); cb++) { // column blocks indexing
+            const size_t cols = blockLength(n, cb, size);
             const double* source = M + (rb * n + cb) * size;  // block matrix of lower triangular part
-            double* destination = T + (cb * n + rb) * size;   // block matrix of higher triangular part
-            for (int i = 0; i < size; i++) {                  // transposing
-                for (int j = 0; j < size; j++) {
-                    destination[i * n + j] = source[j * n + i];
+            double* destination = T + (cb * m + rb) * size;   // block matrix of higher triangular part
+            for (size_t i = 0; i < cols; i++) {               // transposing
+                for (size_t j = 0; j < rows; j++) {
+                    destination[i * m + j] = source[j * n + i];
                 }
             }
         }
@@ -60,21 +68,14 @@ void matTransposeImp(const double* M, double* T, int n) {
 
 // The attribute is necessary to avoid the compiler optimization on the repetitions loops
 int __attribute__((optimize("O0"))) main(int argc, char** argv) {
-    int dim = 0;
+    size_t m = 0;
+    size_t n = 0;
     int rep = 0;
-    if (argc < 2) {
-        printf("Correct usage: program-name [M dimension as exponent of 2] [number of repetitions (default 5)]");
+    if (parseArguments(argc, argv, &m, &n, &rep, NULL) == -1) {
         return 1;
-    } else if (argc == 2) {
-        dim = atoi(argv[1]);
-        rep = 500;
-    } else {
-        dim = atoi(argv[1]);
-        rep = atoi(argv[2]) > 0 ? atoi(argv[2]) : 500;
     }
 
-    unsigned int n = pow(2, dim);
-    printf("Matrix dimension: %d\n\n", n);
+    printf("Matrix dimensions: %zu x %zu\n\n", m, n);
     printf("Repetitions: %d\n\n", rep);
 
     // Variables declaration
@@ -83,44 +84,62 @@ int __attribute__((optimize("O0"))) main(int argc, char** argv) {
     bool symmetric = false;           // symmetry check
     double* M;                        // input matrix
     double* T;                        // transposed matrix
+    struct TLBCounter counter;        // dTLB misses counter
+    long long misses1, misses2;       // dTLB misses of the two routines
 
     // Matrices allocation
-    if (initMatrices(&M, &T, n) == -1) {
+    if (initMatrices(&M, &T, m, n) == -1) {
         printf("Error in allocating matrices!\n\n");
         return -1;
     }
 
+    openTLBCounter(&counter);
+
     // Execution
+    startTLBCounter(&counter);
     clock_gettime(CLOCK_MONOTONIC, &s1);
-    for (int i = 0; i < rep; i++) symmetric = checkSymImp(M, n);
+    for (int i = 0; i < rep; i++) symmetric = checkSymImp(M, m, n);
     clock_gettime(CLOCK_MONOTONIC, &e1);
+    misses1 = stopTLBCounter(&counter, rep);
 
+    startTLBCounter(&counter);
     clock_gettime(CLOCK_MONOTONIC, &s2);
-    for (int i = 0; i < rep; i++) matTransposeImp(M, T, n);
+    for (int i = 0; i < rep; i++) matTransposeImp(M, T, m, n);
     clock_gettime(CLOCK_MONOTONIC, &e2);
+    misses2 = stopTLBCounter(&counter, rep);
     // --------------------------------
 
     // Results printing and saving
     t1 = elapsedTime(s1, e1) / rep;
     t2 = elapsedTime(s2, e2) / rep;
 
-    const int size = BLOCK_SIZE < n ? BLOCK_SIZE : n;
-    flops = (double)(n/size * (n/size + 1) / 2 * size * size) / t1;
-    bandwidth = (double)(2 * n * n * sizeof(double)) / t2;
+    const size_t size = BLOCK_SIZE < n ? BLOCK_SIZE : n;
+    flops = m == n ? (double)n * (n + size) / 2 / t1 : 0;  // rectangular matrices are not checked
+    bandwidth = (double)(2 * m * n * sizeof(double)) / t2;
 
     printf("Sequential execution: symmetry: %s\n", symmetric ? "true" : "false");
     printf("checkSym:\t%.9f seconds\t%10.4g GFLOPS\n", t1, flops * 1e-9);
     printf("matTranspose:\t%.9f seconds\t%10.4g GB/s\n\n", t2, bandwidth * 1e-9);
 
-    testResults(M, T, n);
+    if (misses1 != -1 && misses2 != -1) {
+        printf("dTLB misses per repetition: checkSym %lld, matTranspose %lld\n\n", misses1, misses2);
+        if (saveResultsTLB(CODE, m, n, 1, misses1, misses2) == -1) {
+            printf("Error in saving results!\n\n");
+        }
+    } else {
+        printf("dTLB misses not available (hardware counters restricted)\n\n");
+    }
+
+    testResults(M, T, m, n);
 
-    if (saveResultsILP(CODE, n, flops, bandwidth) == -1) {
+    if (saveResultsILP(CODE, m, n, flops, bandwidth) == -1) {
         printf("Error in saving results!\n\n");
     }
 
-    // Matrices deallocation
+    // Matrices and counter deallocation
     free(M);
     free(T);
+    closeTLBCounter(&counter);
 
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,147 @@
+#include <immintrin.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "functions.h"
+
+#define CODE "CO"
+
+// Side of the sub-matrices below which the recursion stops, can be tuned with -DCUTOFF=...
+#ifndef CUTOFF
+#define CUTOFF 16
+#endif
+
+// Checks M[i][j] == M[j][i] for rows [r0, r1) and columns [c0, c1), splitting the longer dimension
+bool checkSymRect(const double* M, size_t n, size_t r0, size_t r1, size_t c0, size_t c1) {
+    if (r1 - r0 <= CUTOFF && c1 - c0 <= CUTOFF) {
+        bool check = true;
+        for (size_t i = r0; i < r1; i++) {
+            for (size_t j = c0; j < c1; j++) {
+                if (fabs(M[i * n + j] - M[j * n + i]) > EPSILON) {
+                    check = false;
+                }
+            }
+        }
+        return check;
+    }
+
+    if (r1 - r0 >= c1 - c0) {
+        size_t mid = r0 + (r1 - r0) / 2;
+        return checkSymRect(M, n, r0, mid, c0, c1) & checkSymRect(M, n, mid, r1, c0, c1);
+    } else {
+        size_t mid = c0 + (c1 - c0) / 2;
+        return checkSymRect(M, n, r0, r1, c0, mid) & checkSymRect(M, n, r0, r1, mid, c1);
+    }
+}
+
+// Checks the lower triangular part of the diagonal sub-matrix [d0, d1) x [d0, d1), which is split
+// into two smaller triangles and the rectangle below the first one
+bool checkSymTriangle(const double* M, size_t n, size_t d0, size_t d1) {
+    if (d1 - d0 <= CUTOFF) {
+        bool check = true;
+        for (size_t i = d0 + 1; i < d1; i++) {
+            for (size_t j = d0; j < i; j++) {
+                if (fabs(M[i * n + j] - M[j * n + i]) > EPSILON) {
+                    check = false;
+                }
+            }
+        }
+        return check;
+    }
+
+    size_t mid = d0 + (d1 - d0) / 2;
+    return checkSymTriangle(M, n, d0, mid) & checkSymTriangle(M, n, mid, d1) & checkSymRect(M, n, mid, d1, d0, mid);
+}
+
+bool checkSymImp(const double* M, size_t m, size_t n) {
+    if (m != n) return false;  // only square matrices can be symmetric
+    return checkSymTriangle(M, n, 0, n);
+}
+
+// Transposes rows [r0, r1) and columns [c0, c1) of M (m x n) into T (n x m), splitting the longer dimension
+void matTransposeRect(const double* M, double* T, size_t m, size_t n, size_t r0, size_t r1, size_t c0, size_t c1) {
+    if (r1 - r0 <= CUTOFF && c1 - c0 <= CUTOFF) {
+        for (size_t i = r0; i < r1; i++) {
+            for (size_t j = c0; j < c1; j++) {
+                T[j * m + i] = M[i * n + j];
+            }
+        }
+        return;
+    }
+
+    if (r1 - r0 >= c1 - c0) {
+        size_t mid = r0 + (r1 - r0) / 2;
+        matTransposeRect(M, T, m, n, r0, mid, c0, c1);
+        matTransposeRect(M, T, m, n, mid, r1, c0, c1);
+    } else {
+        size_t mid = c0 + (c1 - c0) / 2;
+        matTransposeRect(M, T, m, n, r0, r1, c0, mid);
+        matTransposeRect(M, T, m, n, r0, r1, mid, c1);
+    }
+}
+
+void matTransposeImp(const double* M, double* T, size_t m, size_t n) {
+    matTransposeRect(M, T, m, n, 0, m, 0, n);
+}
+
+// The attribute is necessary to avoid the compiler optimization on the repetitions loops
+int __attribute__((optimize("O0"))) main(int argc, char** argv) {
+    size_t m = 0;
+    size_t n = 0;
+    int rep = 0;
+    if (parseArguments(argc, argv, &m, &n, &rep, NULL) == -1) {
+        return 1;
+    }
+
+    printf("Matrix dimensions: %zu x %zu\n\n", m, n);
+    printf("Repetitions: %d\n\n", rep);
+
+    // Variables declaration
+    struct timespec s1, s2, e1, e2;   // start, end times
+    double t1, t2, flops, bandwidth;  // execution times and performance metrics
+    bool symmetric = false;           // symmetry check
+    double* M;                        // input matrix
+    double* T;                        // transposed matrix
+
+    // Matrices allocation
+    if (initMatrices(&M, &T, m, n) == -1) {
+        printf("Error in allocating matrices!\n\n");
+        return -1;
+    }
+
+    // Execution
+    clock_gettime(CLOCK_MONOTONIC, &s1);
+    for (int i = 0; i < rep; i++) symmetric = checkSymImp(M, m, n);
+    clock_gettime(CLOCK_MONOTONIC, &e1);
+
+    clock_gettime(CLOCK_MONOTONIC, &s2);
+    for (int i = 0; i < rep; i++) matTransposeImp(M, T, m, n);
+    clock_gettime(CLOCK_MONOTONIC, &e2);
+    // --------------------------------
+
+    // Results printing and saving
+    t1 = elapsedTime(s1, e1) / rep;
+    t2 = elapsedTime(s2, e2) / rep;
+
+    flops = m == n ? ((double)n * n / 2 - n) / t1 : 0;  // rectangular matrices are not checked
+    bandwidth = (double)(2 * m * n * sizeof(double)) / t2;
+
+    printf("Sequential execution: symmetry: %s\n", symmetric ? "true" : "false");
+    printf("checkSym:\t%.9f seconds\t%10.4g GFLOPS\n", t1, flops * 1e-9);
+    printf("matTranspose:\t%.9f seconds\t%10.4g GB/s\n\n", t2, bandwidth * 1e-9);
+
+    testResults(M, T, m, n);
+
+    if (saveResultsILP(CODE, m, n, flops, bandwidth) == -1) {
+        printf("Error in saving results!\n\n");
+    }
+
+    // Matrices deallocation
+    free(M);
+    free(T);
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,217 @@
+#ifndef DISPATCH_H
+#define DISPATCH_H
+
+#include <omp.h>
+
+#include "simd.h"
+#include "tuning.h"
+
+// Adaptive dispatcher: checkSymAdaptive and matTransposeAdaptive pick, from the size of the matrix and the available
+// cores, the kernel and the number of threads to use. The choices of every size class are measured once on this CPU
+// (when calibration is enabled) and saved in FILE_NAME_DISPATCH, otherwise they are estimated from the number of
+// elements, so that small matrices are never parallelized.
+
+#define FILE_NAME_DISPATCH "dispatch_profiles.csv"
+
+#define DISPATCH_BLOCK 32
+
+// Kernels of the dispatcher, all blocked with the register tiles of simd.h (scalar code without SIMD flags)
+#define KERNEL_SEQUENTIAL 0  // sequential
+#define KERNEL_STATIC 1      // OpenMP with static schedule
+#define KERNEL_DYNAMIC 2     // OpenMP with dynamic schedule, balances the rows of the triangle of the symmetry check
+
+#define ROUTINE_CHECK 0
+#define ROUTINE_TRANSPOSE 1
+
+// Estimate used without calibration: matrices with fewer elements than DISPATCH_MIN_ELEMENTS are processed
+// sequentially (the results of O, OR and OB do not scale below n = 1024), the others with a thread every
+// DISPATCH_ELEMENTS_PER_THREAD elements. Both can be tuned at compile time.
+#ifndef DISPATCH_MIN_ELEMENTS
+#define DISPATCH_MIN_ELEMENTS (1UL << 20)
+#endif
+#ifndef DISPATCH_ELEMENTS_PER_THREAD
+#define DISPATCH_ELEMENTS_PER_THREAD (1UL << 18)
+#endif
+
+// Repetitions of every candidate during the calibration, the fastest one is kept
+#define CALIBRATION_REPS 5
+
+struct DispatchOptions {
+    int threads;     // maximum number of threads, 0 for all the cores
+    bool calibrate;  // measure the kernels when the size class is missing from the profiles
+};
+
+struct Dispatch {
+    int kernel;
+    int threads;
+};
+
+// Choices already made in this process, by routine, size class and exponent of the maximum number of threads
+struct Dispatch dispatchCache[2][64][8];
+bool dispatchCached[2][64][8];
+
+static inline bool checkSymKernel(const double* M, size_t n, int kernel, int threads) {
+    const size_t size = DISPATCH_BLOCK < n ? DISPATCH_BLOCK : n;
+    const size_t blocks = blockCount(n, size);
+    bool check = true;
+
+#pragma omp parallel for if (kernel != KERNEL_SEQUENTIAL) num_threads(threads) schedule(runtime) reduction(&& : check)
+    for (size_t rb = 0; rb < blocks; rb++) {                 // row blocks indexing
+        for (size_t cb = 0; cb <= rb; cb++) {                // column blocks indexing
+            const double* first = M + (rb * n + cb) * size;  // block matrix of lower triangular part
+            const double* last = M + (cb * n + rb) * size;   // block matrix of higher triangular part
+            check &= checkBlock(first, last, n, blockLength(n, rb, size), blockLength(n, cb, size), rb == cb);
+        }
+    }
+
+    return check;
+}
+
+static inline void matTransposeKernel(const double* M, double* T, size_t m, size_t n, int kernel, int threads) {
+    const size_t size = DISPATCH_BLOCK < n ? DISPATCH_BLOCK : n;
+    const size_t row_blocks = blockCount(m, size);
+    const size_t col_blocks = blockCount(n, size);
+
+#pragma omp parallel for if (kernel != KERNEL_SEQUENTIAL) num_threads(threads) collapse(2) schedule(runtime)
+    for (size_t rb = 0; rb < row_blocks; rb++) {      // row blocks indexing
+        for (size_t cb = 0; cb < col_blocks; cb++) {  // column blocks indexing
+            transposeBlock(M + (rb * n + cb) * size, n, T + (cb * m + rb) * size, m, blockLength(m, rb, size), blockLength(n, cb, size));
+        }
+    }
+}
+
+// Runs a routine with the kernel and the threads of choice, the schedule is applied through schedule(runtime)
+static inline bool runDispatch(int routine, const double* M, double* T, size_t m, size_t n, const struct Dispatch* choice) {
+    omp_set_schedule(choice->kernel == KERNEL_DYNAMIC ? omp_sched_dynamic : omp_sched_static, 0);
+
+    if (routine == ROUTINE_CHECK) return m == n && checkSymKernel(M, n, choice->kernel, choice->threads);  // only square matrices can be symmetric
+
+    matTransposeKernel(M, T, m, n, choice->kernel, choice->threads);
+    return true;
+}
+
+// Loads the choice saved for the routine on this CPU for the size class and the maximum threads, -1 if missing
+int loadDispatch(int routine, int size_class, int max_threads, struct Dispatch* choice) {
+    char model[64], line[256], cpu[64];
+    int r, c, t, found = -1;
+    struct Dispatch d;
+
+    cpuModel(model, sizeof(model));
+
+    FILE* f = fopen(FILE_NAME_DISPATCH, "r");
+    if (f == NULL) return -1;
+
+    while (fgets(line, sizeof(line), f) != NULL) {
+        if (sscanf(line, "%63[^,],%d,%d,%d,%d,%d", cpu, &r, &c, &t, &d.kernel, &d.threads) != 6) continue;
+        if (strcmp(cpu, model) == 0 && r == routine && c == size_class && t == max_threads) {
+            *choice = d;  // choices appended later override the previous ones
+            found = 0;
+        }
+    }
+    fclose(f);
+
+    return found;
+}
+
+int saveDispatch(int routine, int size_class, int max_threads, const struct Dispatch* choice) {
+    char model[64];
+    cpuModel(model, sizeof(model));
+
+    FILE* f = fopen(FILE_NAME_DISPATCH, "a");
+
+    if (f == NULL) return -1;
+
+    if (ftell(f) == 0) fprintf(f, "cpu,routine,class,max_threads,kernel,threads\n");
+    fprintf(f, "%s,%d,%d,%d,%d,%d\n", model, routine, size_class, max_threads, choice->kernel, choice->threads);
+    fclose(f);
+
+    return 0;
+}
+
+// Times every kernel with 2, 4, ... up to max_threads threads on the passed matrices and returns the fastest choice,
+// the sequential kernel unless a parallel one beats it
+struct Dispatch calibrateDispatch(int routine, const double* M, double* T, size_t m, size_t n, int max_threads) {
+    struct Dispatch best = {KERNEL_SEQUENTIAL, 1}, candidate;
+    double best_time = 0;
+
+    for (int kernel = KERNEL_SEQUENTIAL; kernel <= KERNEL_DYNAMIC; kernel++) {
+        for (int threads = kernel == KERNEL_SEQUENTIAL ? 1 : 2; threads <= max_threads; threads *= 2) {
+            candidate.kernel = kernel;
+            candidate.threads = threads;
+            runDispatch(routine, M, T, m, n, &candidate);  // warm up of the caches and of the team
+
+            double time = 0;
+            for (int i = 0; i < CALIBRATION_REPS; i++) {
+                double start = omp_get_wtime();
+                runDispatch(routine, M, T, m, n, &candidate);
+                double t = omp_get_wtime() - start;
+                if (i == 0 || t < time) time = t;
+            }
+
+            if (kernel == KERNEL_SEQUENTIAL || time < best_time) {
+                best = candidate;
+                best_time = time;
+            }
+            if (kernel == KERNEL_SEQUENTIAL) break;
+        }
+    }
+
+    return best;
+}
+
+// Estimated choice without calibration
+struct Dispatch estimateDispatch(int routine, size_t m, size_t n, int max_threads) {
+    struct Dispatch choice = {KERNEL_SEQUENTIAL, 1};
+
+    if (m * n >= DISPATCH_MIN_ELEMENTS && max_threads > 1) {
+        choice.kernel = routine == ROUTINE_CHECK ? KERNEL_DYNAMIC : KERNEL_STATIC;
+        choice.threads = m * n / DISPATCH_ELEMENTS_PER_THREAD < (size_t)max_threads ? (int)(m * n / DISPATCH_ELEMENTS_PER_THREAD) : max_threads;
+        if (choice.threads < 2) choice.threads = 2;
+    }
+
+    return choice;
+}
+
+// Choice for a routine on an m x n matrix: the one already made in this process, the one saved in the profiles,
+// a calibration on the passed matrices or the estimate, in this order
+struct Dispatch chooseDispatch(int routine, const double* M, double* T, size_t m, size_t n, const struct DispatchOptions* options) {
+    const int cores = omp_get_num_procs();
+    int max_threads = options->threads > 0 && options->threads < cores ? options->threads : cores;
+    int e = 0;
+    while (e < 7 && (2 << e) <= max_threads) e++;  // the maximum threads are rounded down to a power of two
+    max_threads = 1 << e;
+    const int size_class = sizeClass(m, n);
+
+    if (!dispatchCached[routine][size_class][e]) {
+        struct Dispatch choice;
+        if (loadDispatch(routine, size_class, max_threads, &choice) == -1) {
+            if (options->calibrate) {
+                choice = calibrateDispatch(routine, M, T, m, n, max_threads);
+                saveDispatch(routine, size_class, max_threads, &choice);
+            } else {
+                choice = estimateDispatch(routine, m, n, max_threads);
+            }
+        }
+        dispatchCache[routine][size_class][e] = choice;
+        dispatchCached[routine][size_class][e] = true;
+    }
+
+    return dispatchCache[routine][size_class][e];
+}
+
+bool checkSymAdaptive(const double* M, size_t m, size_t n, const struct DispatchOptions* options) {
+    const struct Dispatch choice = chooseDispatch(ROUTINE_CHECK, M, NULL, m, n, options);
+    return runDispatch(ROUTINE_CHECK, M, NULL, m, n, &choice);
+}
+
+void matTransposeAdaptive(const double* M, double* T, size_t m, size_t n, const struct DispatchOptions* options) {
+    const struct Dispatch choice = chooseDispatch(ROUTINE_TRANSPOSE, M, T, m, n, options);
+    runDispatch(ROUTINE_TRANSPOSE, M, T, m, n, &choice);
+}
+
+void printDispatch(const char* routine, const struct Dispatch* choice) {
+    const char* kernels[] = {"sequential", "static", "dynamic"};
+    printf("%s: %s kernel with %d threads\n", routine, kernels[choice->kernel], choice->threads);
+}
+
+#endif
\ No newline at end of file
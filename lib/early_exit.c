@@ -0,0 +1,115 @@
+#include <immintrin.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "functions.h"
+#include "simd.h"
+
+#define CODE "E"
+
+#define BLOCK_SIZE 32
+
+bool checkSymImp(const double* M, size_t m, size_t n) {
+    if (m != n) return false;  // only square matrices can be symmetric
+    const size_t size = BLOCK_SIZE < n ? BLOCK_SIZE : n;
+    const size_t blocks = blockCount(n, size);
+    bool check = true;
+
+    for (size_t rb = 0; rb < blocks; rb++) {                 // row blocks indexing
+        for (size_t cb = 0; cb <= rb; cb++) {                // column blocks indexing
+            const double* first = M + (rb * n + cb) * size;  // block matrix of lower triangular part
+            const double* last = M + (cb * n + rb) * size;   // block matrix of higher triangular part
+            check &= checkBlock(first, last, n, blockLength(n, rb, size), blockLength(n, cb, size), rb == cb);
+        }
+    }
+
+    return check;
+}
+
+// Same traversal of checkSymImp, returning at the first pair of blocks that is not symmetric.
+// The time of the rejection is saved in detected.
+bool checkSymEarlyExit(const double* M, size_t m, size_t n, struct timespec* detected) {
+    if (m != n) {  // only square matrices can be symmetric
+        clock_gettime(CLOCK_MONOTONIC, detected);
+        return false;
+    }
+    const size_t size = BLOCK_SIZE < n ? BLOCK_SIZE : n;
+    const size_t blocks = blockCount(n, size);
+
+    for (size_t rb = 0; rb < blocks; rb++) {                 // row blocks indexing
+        for (size_t cb = 0; cb <= rb; cb++) {                // column blocks indexing
+            const double* first = M + (rb * n + cb) * size;  // block matrix of lower triangular part
+            const double* last = M + (cb * n + rb) * size;   // block matrix of higher triangular part
+            if (!checkBlock(first, last, n, blockLength(n, rb, size), blockLength(n, cb, size), rb == cb)) {
+                clock_gettime(CLOCK_MONOTONIC, detected);
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+// The attribute is necessary to avoid the compiler optimization on the repetitions loops
+int __attribute__((optimize("O0"))) main(int argc, char** argv) {
+    size_t m = 0;
+    size_t n = 0;
+    int rep = 0;
+    if (parseArguments(argc, argv, &m, &n, &rep, NULL) == -1) {
+        return 1;
+    }
+
+    printf("Matrix dimensions: %zu x %zu\n\n", m, n);
+    printf("Repetitions: %d\n\n", rep);
+
+    // Variables declaration
+    struct timespec s1, s2, e1, e2, d2;        // start, end and rejection times
+    double t1, t2 = 0, rejection = 0;          // execution times
+    bool symmetric = false, early = false;     // symmetry checks
+    double* M;                                 // input matrix
+
+    // Matrix allocation
+    if (initMatrix(&M, m, n) == -1) {
+        printf("Error in allocating matrices!\n\n");
+        return -1;
+    }
+
+    // Execution
+    clock_gettime(CLOCK_MONOTONIC, &s1);
+    for (int i = 0; i < rep; i++) symmetric = checkSymImp(M, m, n);
+    clock_gettime(CLOCK_MONOTONIC, &e1);
+
+    for (int i = 0; i < rep; i++) {
+        clock_gettime(CLOCK_MONOTONIC, &s2);
+        early = checkSymEarlyExit(M, m, n, &d2);
+        clock_gettime(CLOCK_MONOTONIC, &e2);
+
+        t2 += elapsedTime(s2, e2);
+        rejection += early ? elapsedTime(s2, e2) : elapsedTime(s2, d2);  // symmetric inputs are never rejected
+    }
+    // --------------------------------
+
+    // Results printing and saving
+    t1 = elapsedTime(s1, e1) / rep;
+    t2 = t2 / rep;
+    rejection = rejection / rep;
+
+    printf("Sequential execution: symmetry: %s\n", early ? "true" : "false");
+    printf("checkSym (full scan):\t%.9f seconds\n", t1);
+    printf("checkSym (early exit):\t%.9f seconds\n", t2);
+    printf("first rejection:\t%.9f seconds\n\n", rejection);
+
+    printf("Tested results: early exit %s.\n\n", symmetric == early ? "correct" : "incorrect");
+
+    if (saveResultsEarlyExit(CODE, m, n, 1, t1, rejection, t2) == -1) {
+        printf("Error in saving results!\n\n");
+    }
+
+    // Matrix deallocation
+    free(M);
+
+    return 0;
+}
\ No newline at end of file
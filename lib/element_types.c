@@ -0,0 +1,88 @@
+#include <float.h>
+#include <immintrin.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "functions.h"
+#include "types.h"
+
+// The codes of the results are B_ followed by the element type (B_F16, B_BF16, B_F32, B_F64, B_I32, B_I64, B_C128)
+
+// Defines benchmark_name, which times the blocked kernels check and transpose on matrices of type and saves the
+// results with code. The bandwidth is computed with the size of the element type.
+// The attribute is necessary to avoid the compiler optimization on the repetitions loops
+#define BENCHMARK(name, type, code, check, transpose)                                                 \
+    int __attribute__((optimize("O0"))) benchmark_##name(size_t m, size_t n, int rep) {              \
+        struct timespec s1, s2, e1, e2;  /* start, end times */                                      \
+        double t1, t2, flops, bandwidth; /* execution times and performance metrics */               \
+        bool symmetric = false;          /* symmetry check */                                        \
+        type* M;                         /* input matrix */                                          \
+        type* T;                         /* transposed matrix */                                     \
+                                                                                                     \
+        if (initMatrices_##name(&M, &T, m, n) == -1) {                                               \
+            printf("Error in allocating matrices!\n\n");                                             \
+            return -1;                                                                               \
+        }                                                                                            \
+                                                                                                     \
+        clock_gettime(CLOCK_MONOTONIC, &s1);                                                         \
+        for (int i = 0; i < rep; i++) symmetric = check(M, m, n);                                    \
+        clock_gettime(CLOCK_MONOTONIC, &e1);                                                         \
+                                                                                                     \
+        clock_gettime(CLOCK_MONOTONIC, &s2);                                                         \
+        for (int i = 0; i < rep; i++) transpose(M, T, m, n);                                         \
+        clock_gettime(CLOCK_MONOTONIC, &e2);                                                         \
+                                                                                                     \
+        t1 = elapsedTime(s1, e1) / rep;                                                              \
+        t2 = elapsedTime(s2, e2) / rep;                                                              \
+                                                                                                     \
+        flops = m == n ? ((double)n * n / 2 - n) / t1 : 0; /* rectangular matrices are not checked */ \
+        bandwidth = (double)(2 * m * n * sizeof(type)) / t2;                                         \
+                                                                                                     \
+        printf("%s (%s, %zu bytes): symmetry: %s\n", code, #type, sizeof(type), symmetric ? "true" : "false"); \
+        printf("checkSym:\t%.9f seconds\t%10.4g GFLOPS\n", t1, flops * 1e-9);                        \
+        printf("matTranspose:\t%.9f seconds\t%10.4g GB/s\n", t2, bandwidth * 1e-9);                  \
+        printf("Tested results: transposed %s.\n\n", isTransposed_##name(M, T, m, n) ? "correct" : "incorrect"); \
+                                                                                                     \
+        if (saveResultsILP(code, m, n, flops, bandwidth) == -1) {                                    \
+            printf("Error in saving results!\n\n");                                                  \
+        }                                                                                            \
+                                                                                                     \
+        free(M);                                                                                     \
+        free(T);                                                                                     \
+        return 0;                                                                                    \
+    }
+
+BENCHMARK(f16, half, "B_F16", checkSymGeneric, matTransposeGeneric)
+BENCHMARK(bf16, bfloat16, "B_BF16", checkSymGeneric, matTransposeGeneric)
+BENCHMARK(f32, float, "B_F32", checkSymGeneric, matTransposeGeneric)
+BENCHMARK(f64, double, "B_F64", checkSymGeneric, matTransposeGeneric)
+BENCHMARK(i32, int32_t, "B_I32", checkSymGeneric, matTransposeGeneric)
+BENCHMARK(i64, int64_t, "B_I64", checkSymGeneric, matTransposeGeneric)
+BENCHMARK(c128h, complex double, "B_C128", checkHermitian, matConjTranspose)  // Hermitian check and conjugate transpose
+
+int main(int argc, char** argv) {
+    size_t m = 0;
+    size_t n = 0;
+    int rep = 0;
+    if (parseArguments(argc, argv, &m, &n, &rep, NULL) == -1) {
+        return 1;
+    }
+    if (inputFile != NULL || outputFile != NULL) {  // only row-major double matrices are loaded and saved
+        printf("Error: --input and --output are not supported by this program!\n\n");
+        return 1;
+    }
+
+    printf("Matrix dimensions: %zu x %zu\n\n", m, n);
+    printf("Repetitions: %d\n\n", rep);
+
+    // Executions, from the narrowest element type
+    if (benchmark_f16(m, n, rep) == -1 || benchmark_bf16(m, n, rep) == -1 || benchmark_f32(m, n, rep) == -1 || benchmark_f64(m, n, rep) == -1 ||
+        benchmark_i32(m, n, rep) == -1 || benchmark_i64(m, n, rep) == -1 || benchmark_c128h(m, n, rep) == -1) {
+        return -1;
+    }
+
+    return 0;
+}
\ No newline at end of file
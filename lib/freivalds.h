@@ -0,0 +1,174 @@
+#ifndef FREIVALDS_H
+#define FREIVALDS_H
+
+#include <float.h>
+#include <omp.h>
+#include <time.h>
+
+#include "simd.h"
+
+// Randomized symmetry pre-filter in the style of Freivalds: M is symmetric only if M r == M^T r for every vector r.
+// Both products are accumulated in a single row-major pass over M, without the strided accesses to M[j][i] of the
+// exact kernels: row i adds row[j] * r[j] to (M r)[i] and row[j] * r[i] to (M^T r)[j]. The entries of r are random
+// signs (+1 or -1) drawn at every call.
+// The products are compared with a tolerance covering the differences below EPSILON accepted by the exact kernels and
+// the rounding errors of the sums, so a matrix accepted by the exact check is never rejected. A matrix with a
+// difference greater than twice the tolerance passes a trial with probability at most 1/2, so it is accepted (and
+// checked exactly) with probability at most 2^-FREIVALDS_TRIALS.
+
+// Trials, i.e. random vectors r, of every pass: the false accept probability is at most 2^-FREIVALDS_TRIALS. It can be
+// changed at compile time with -DFREIVALDS_TRIALS=... (e.g. 20 for about 1e-6)
+#ifndef FREIVALDS_TRIALS
+#define FREIVALDS_TRIALS 4
+#endif
+
+// Random signs of the trials, R[t][j] for trial t, drawn from a new seed at every call
+void freivaldsVectors(double* R, size_t n) {
+    static unsigned long long calls = 0;
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    const unsigned long long seed = mix64(now.tv_nsec ^ ((unsigned long long)now.tv_sec << 32) ^ mix64(++calls));
+
+    for (size_t k = 0; k < FREIVALDS_TRIALS * n; k += 64) {
+        const unsigned long long bits = mix64(seed + k);
+        for (size_t b = 0; b < 64 && k + b < FREIVALDS_TRIALS * n; b++) R[k + b] = (bits >> b) & 1 ? 1.0 : -1.0;
+    }
+}
+
+// Adds rows i and i + 1 of M (n elements each, first and second) to the products of the trials: y[t] = sum_j
+// first[j] * R[t][j] is (M r)[i], y[FREIVALDS_TRIALS + t] is (M r)[i + 1] and Z[t][j] += first[j] * R[t][i] +
+// second[j] * R[t][i + 1] accumulates M^T r, loaded and stored once for both rows. With single, the last row of an odd
+// matrix, second is first with weight 0. Returns the maximum absolute value of the rows
+static inline double freivaldsRows(const double* first, const double* second, size_t i, bool single, size_t n, const double* R, double* Z, double* y) {
+    double s0[FREIVALDS_TRIALS], s1[FREIVALDS_TRIALS];  // weights of the rows, R[t][i] and R[t][i + 1]
+    for (int t = 0; t < FREIVALDS_TRIALS; t++) {
+        s0[t] = R[t * n + i];
+        s1[t] = single ? 0 : R[t * n + i + 1];
+    }
+    size_t j = 0;
+    double top = 0;
+#if defined(__AVX512F__)
+    __m512d acc0[FREIVALDS_TRIALS], acc1[FREIVALDS_TRIALS];
+    __m512d top_vec = _mm512_setzero_pd();
+    for (int t = 0; t < FREIVALDS_TRIALS; t++) acc0[t] = acc1[t] = _mm512_setzero_pd();
+    for (; j + 8 <= n; j += 8) {
+        const __m512d x0 = _mm512_loadu_pd(first + j);
+        const __m512d x1 = _mm512_loadu_pd(second + j);
+        top_vec = _mm512_max_pd(top_vec, _mm512_max_pd(_mm512_abs_pd(x0), _mm512_abs_pd(x1)));
+        for (int t = 0; t < FREIVALDS_TRIALS; t++) {
+            const __m512d r = _mm512_loadu_pd(R + t * n + j);
+            acc0[t] = _mm512_fmadd_pd(x0, r, acc0[t]);
+            acc1[t] = _mm512_fmadd_pd(x1, r, acc1[t]);
+            __m512d z = _mm512_fmadd_pd(x0, _mm512_set1_pd(s0[t]), _mm512_loadu_pd(Z + t * n + j));
+            _mm512_storeu_pd(Z + t * n + j, _mm512_fmadd_pd(x1, _mm512_set1_pd(s1[t]), z));
+        }
+    }
+    top = _mm512_reduce_max_pd(top_vec);
+    for (int t = 0; t < FREIVALDS_TRIALS; t++) {
+        y[t] = _mm512_reduce_add_pd(acc0[t]);
+        y[FREIVALDS_TRIALS + t] = _mm512_reduce_add_pd(acc1[t]);
+    }
+#elif defined(__AVX2__)
+    __m256d acc0[FREIVALDS_TRIALS], acc1[FREIVALDS_TRIALS];
+    __m256d top_vec = _mm256_setzero_pd();
+    const __m256d sign = _mm256_set1_pd(-0.0);
+    for (int t = 0; t < FREIVALDS_TRIALS; t++) acc0[t] = acc1[t] = _mm256_setzero_pd();
+    for (; j + 4 <= n; j += 4) {
+        const __m256d x0 = _mm256_loadu_pd(first + j);
+        const __m256d x1 = _mm256_loadu_pd(second + j);
+        top_vec = _mm256_max_pd(top_vec, _mm256_max_pd(_mm256_andnot_pd(sign, x0), _mm256_andnot_pd(sign, x1)));
+        for (int t = 0; t < FREIVALDS_TRIALS; t++) {
+            const __m256d r = _mm256_loadu_pd(R + t * n + j);
+            acc0[t] = _mm256_add_pd(acc0[t], _mm256_mul_pd(x0, r));
+            acc1[t] = _mm256_add_pd(acc1[t], _mm256_mul_pd(x1, r));
+            __m256d z = _mm256_add_pd(_mm256_loadu_pd(Z + t * n + j), _mm256_mul_pd(x0, _mm256_set1_pd(s0[t])));
+            _mm256_storeu_pd(Z + t * n + j, _mm256_add_pd(z, _mm256_mul_pd(x1, _mm256_set1_pd(s1[t]))));
+        }
+    }
+    double lanes[4];
+    _mm256_storeu_pd(lanes, top_vec);
+    top = fmax(fmax(lanes[0], lanes[1]), fmax(lanes[2], lanes[3]));
+    for (int t = 0; t < FREIVALDS_TRIALS; t++) {
+        _mm256_storeu_pd(lanes, acc0[t]);
+        y[t] = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+        _mm256_storeu_pd(lanes, acc1[t]);
+        y[FREIVALDS_TRIALS + t] = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    }
+#else
+    for (int t = 0; t < 2 * FREIVALDS_TRIALS; t++) y[t] = 0;
+#endif
+
+    for (; j < n; j++) {  // elements outside of the vectors
+        top = fmax(top, fmax(fabs(first[j]), fabs(second[j])));
+        for (int t = 0; t < FREIVALDS_TRIALS; t++) {
+            y[t] += first[j] * R[t * n + j];
+            y[FREIVALDS_TRIALS + t] += second[j] * R[t * n + j];
+            Z[t * n + j] += first[j] * s0[t] + second[j] * s1[t];
+        }
+    }
+
+    return top;
+}
+
+// Pre-filter of the symmetry check: returns false if M is certainly not symmetric, true if it may be symmetric (and
+// should be checked exactly). The pairs of rows are distributed statically on the threads, every thread accumulates M^T r in
+// its own copy of Z, summed at the end.
+bool checkSymFreivalds(const double* M, size_t m, size_t n) {
+    if (m != n) return false;  // only square matrices can be symmetric
+    const int threads = omp_get_max_threads();
+    double* R = allocMatrix(FREIVALDS_TRIALS, n);
+    double* Y = allocMatrix(FREIVALDS_TRIALS, n);                    // (M r)[i] of every trial, by row
+    double* Z = allocMatrix((size_t)threads * FREIVALDS_TRIALS, n);  // M^T r of every trial and thread
+    double top = 0;                                                  // maximum absolute value of M
+    int used = 1;                                                    // threads of the pass
+    bool candidate = true;
+
+    if (R == NULL || Y == NULL || Z == NULL) {  // without memory the filter lets the exact check decide
+        free(R);
+        free(Y);
+        free(Z);
+        return true;
+    }
+    freivaldsVectors(R, n);
+
+#pragma omp parallel reduction(max : top)
+    {
+        double* z = Z + (size_t)omp_get_thread_num() * FREIVALDS_TRIALS * n;
+        for (size_t k = 0; k < FREIVALDS_TRIALS * n; k++) z[k] = 0;
+
+        if (omp_get_thread_num() == 0) used = omp_get_num_threads();  // the team can be smaller than threads
+
+#pragma omp for schedule(static)
+        for (size_t p = 0; p < (n + 1) / 2; p++) {  // pairs of rows
+            const size_t i = 2 * p;
+            double y[2 * FREIVALDS_TRIALS];
+            const bool single = i + 1 == n;
+            top = fmax(top, freivaldsRows(M + i * n, M + (single ? i : i + 1) * n, i, single, n, R, z, y));
+            for (int t = 0; t < FREIVALDS_TRIALS; t++) {
+                Y[i * FREIVALDS_TRIALS + t] = y[t];
+                if (!single) Y[(i + 1) * FREIVALDS_TRIALS + t] = y[FREIVALDS_TRIALS + t];
+            }
+        }
+    }
+
+    // Tolerance: differences below EPSILON add up to n * EPSILON, and each sum of n products of magnitude at most
+    // top has a rounding error below n * top * n * DBL_EPSILON
+    const double tolerance = n * EPSILON + 4.0 * n * n * top * DBL_EPSILON;
+
+#pragma omp parallel for schedule(static) reduction(&& : candidate)
+    for (size_t i = 0; i < n; i++) {
+        for (int t = 0; t < FREIVALDS_TRIALS; t++) {
+            double z = 0;
+            for (int p = 0; p < used; p++) z += Z[((size_t)p * FREIVALDS_TRIALS + t) * n + i];
+            if (fabs(Y[i * FREIVALDS_TRIALS + t] - z) > tolerance) candidate = false;
+        }
+    }
+
+    free(R);
+    free(Y);
+    free(Z);
+
+    return candidate;
+}
+
+#endif
\ No newline at end of file
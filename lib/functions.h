@@ -1,14 +1,120 @@
+#include <fcntl.h>
+#include <linux/perf_event.h>
 #include <omp.h>
+#include <stdint.h>
 #include <stdio.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
 #include <unistd.h>
 
 #define EPSILON 1e-6
 #define FILE_NAME_ILP "results_ilp.csv"
 #define FILE_NAME_OMP "results_omp.csv"
+#define FILE_NAME_EARLY_EXIT "results_early_exit.csv"
+#define FILE_NAME_TLB "results_tlb.csv"
+#define FILE_NAME_NUMA "results_numa.csv"
+#define FILE_NAME_BATCHED "results_batched.csv"
+#define FILE_NAME_FORK_JOIN "results_fork_join.csv"
+#define FILE_NAME_FUSED "results_fused.csv"
+#define FILE_NAME_PACKED "results_packed.csv"
+#define FILE_NAME_OUT_OF_CORE "results_out_of_core.csv"
+#define FILE_NAME_STREAMING "results_streaming.csv"
+#define FILE_NAME_FREIVALDS "results_freivalds.csv"
+#define FILE_NAME_TRACKED "results_tracked.csv"
+#define FILE_NAME_TRACKED_TRANSPOSE "results_tracked_transpose.csv"
 
-void printMatrix(const double* M, int n) {
-    for (int i = 0; i < n; i++) {
-        for (int j = 0; j < n; j++) {
+// Alignment of the matrices: a cache line, a huge page (2 MiB) when compiled with -DHUGE_PAGES or a disk block
+// (4 KiB) when compiled with -DDIRECT_IO, so that the matrix files can be read and written with O_DIRECT
+#if defined(HUGE_PAGES)
+#define ALIGNMENT (2UL * 1024 * 1024)
+#elif defined(DIRECT_IO)
+#define ALIGNMENT 4096UL
+#else
+#define ALIGNMENT 64UL
+#endif
+
+// O_DIRECT is only declared by fcntl.h with _GNU_SOURCE, which must be defined before the first system header: its
+// value differs between the architectures, so -DDIRECT_IO builds also pass -D_GNU_SOURCE
+#if defined(DIRECT_IO) && !defined(O_DIRECT)
+#error "-DDIRECT_IO needs O_DIRECT: compile with -D_GNU_SOURCE"
+#endif
+
+// OpenMP directive of the shared helpers, dropped in the sequential programs so that they compile without warnings
+// about unknown pragmas: OMP_PRAGMA(omp parallel for) is #pragma omp parallel for with -fopenmp
+#ifdef _OPENMP
+#define OMP_PRAGMA(directive) _Pragma(#directive)
+#else
+#define OMP_PRAGMA(directive)
+#endif
+
+// Workload classes of the input matrix, selected at runtime with the WORKLOAD environment variable
+#define WORKLOAD_RANDOM 0     // independent random values, rejected by the symmetry check
+#define WORKLOAD_SYMMETRIC 1  // M[i][j] == M[j][i], the symmetry check scans the whole lower triangular part
+#define WORKLOAD_PERTURBED 2  // symmetric with some elements of the lower triangular part changed by 1
+#define WORKLOAD_NEAR 3       // symmetric up to differences smaller than EPSILON
+
+// Side of the tiles generated from the same key, equal to BLOCK_SIZE so that every block is touched by one thread
+#define GENERATOR_TILE 32
+
+struct Workload {
+    int kind;
+    size_t perturbations;  // number of perturbed elements
+    double position;       // relative row of the perturbations: 0 early, 0.5 middle and 1 late in the scan order
+    unsigned long long seed;
+};
+
+// The input matrices are reproducible: the same seed gives the same matrix whatever the number of threads
+struct Workload workload = {WORKLOAD_RANDOM, 0, 0, 42};
+
+// Binary matrix files: a header of 64 bytes followed, at offset MATRIX_FILE_ALIGNMENT, by the elements. The payload
+// is aligned to a disk block (and then to a cache line), so that it can be read and written with O_DIRECT.
+#define MATRIX_FILE_MAGIC "SYMTRMAT"
+#define MATRIX_FILE_VERSION 1
+#define MATRIX_FILE_ALIGNMENT 4096
+
+// Chunk of the payload read or written by a thread with a single pread or pwrite
+#define MATRIX_FILE_CHUNK (8UL * 1024 * 1024)
+
+// Element types of the matrix files, the suffixes of the programs of types.h
+#define MATRIX_F64 0
+#define MATRIX_F32 1
+#define MATRIX_F16 2
+#define MATRIX_BF16 3
+#define MATRIX_I32 4
+#define MATRIX_I64 5
+#define MATRIX_C128 6
+
+// Layouts of the matrix files: row-major with rows of ld elements, or the packed symmetric layouts of packed.h
+#define MATRIX_ROW_MAJOR 0
+#define MATRIX_PACKED_LOWER 1
+#define MATRIX_PACKED_RFP 2
+
+struct MatrixHeader {
+    char magic[8];          // MATRIX_FILE_MAGIC, without terminator
+    uint32_t version;       // MATRIX_FILE_VERSION
+    uint32_t type;          // element type
+    uint32_t layout;        // layout of the elements
+    uint32_t element_size;  // bytes of an element
+    uint64_t rows;
+    uint64_t cols;
+    uint64_t ld;            // leading dimension: elements between the starts of two rows
+    uint64_t offset;        // offset in bytes of the first element
+    uint64_t reserved;
+};
+
+// Files passed with --input and --output: M is loaded from the first one instead of being generated and T is saved
+// in the second one at the end of the program, by testResults
+const char* inputFile = NULL;
+const char* outputFile = NULL;
+
+// Matrices are stored in row-major order: M has m rows and n columns, so M[i][j] = M[i * n + j]
+// and its transpose T has n rows and m columns, so T[j][i] = T[j * m + i]
+
+void printMatrix(const double* M, size_t m, size_t n) {
+    for (size_t i = 0; i < m; i++) {
+        for (size_t j = 0; j < n; j++) {
             printf("%10g ", M[i * n + j]);
         }
         printf("\n");
@@ -16,6 +122,25 @@ void printMatrix(const double* M, int n) {
     printf("\n");
 }
 
+// Number of blocks of side size needed to cover a dimension of length n
+size_t blockCount(size_t n, size_t size) {
+    return (n + size - 1) / size;
+}
+
+// Length of the b-th block of side size along a dimension of length n, the last block can be smaller
+size_t blockLength(size_t n, size_t b, size_t size) {
+    return n - b * size < size ? n - b * size : size;
+}
+
+// Thread counts of the executions: the powers of 2 up to 64 when threads is 0, otherwise only threads, after the
+// sequential execution when sequential is true. Returns the count following i (the first one when i is 0), 0 after the last
+// one: for (int i = nextThreads(0, threads, true); i != 0; i = nextThreads(i, threads, true))
+int nextThreads(int i, int threads, bool sequential) {
+    if (threads == 0) return i == 0 ? (sequential ? 1 : 2) : i < 64 ? 2 * i : 0;
+    if (i == 0 && sequential) return 1;
+    return i == threads ? 0 : threads;
+}
+
 double elapsedTime(struct timespec s, struct timespec e) {
     long seconds = e.tv_sec - s.tv_sec;
     long nanoseconds = e.tv_nsec - s.tv_nsec;
@@ -23,62 +148,646 @@ double elapsedTime(struct timespec s, struct timespec e) {
     return time;
 }
 
-int saveResultsILP(const char* code, int n, double flops, double bandwidth) {
+// Parses the dimensions of M, passed either as N (square matrix) or as ROWSxCOLUMNS
+int parseDimensions(const char* arg, size_t* m, size_t* n) {
+    char* end;
+
+    *m = strtoull(arg, &end, 10);
+    *n = *end == 'x' ? strtoull(end + 1, &end, 10) : *m;
+
+    return *end != '\0' || *m == 0 || *n == 0 ? -1 : 0;
+}
+
+// Parses a workload class: random, symmetric, near or perturbed[:K[:early|middle|late]] (default 1 perturbation in the middle)
+int parseWorkload(const char* arg, struct Workload* w) {
+    char position[16] = "middle";
+    int k = 1;
+
+    if (strcmp(arg, "random") == 0) w->kind = WORKLOAD_RANDOM;
+    else if (strcmp(arg, "symmetric") == 0) w->kind = WORKLOAD_SYMMETRIC;
+    else if (strcmp(arg, "near") == 0) w->kind = WORKLOAD_NEAR;
+    else if (strncmp(arg, "perturbed", 9) == 0 && (arg[9] == '\0' || sscanf(arg + 9, ":%d:%15s", &k, position) >= 1) && k > 0) {
+        w->kind = WORKLOAD_PERTURBED;
+        w->perturbations = k;
+        if (strcmp(position, "early") == 0) w->position = 0;
+        else if (strcmp(position, "middle") == 0) w->position = 0.5;
+        else if (strcmp(position, "late") == 0) w->position = 1;
+        else return -1;
+    } else return -1;
+
+    return 0;
+}
+
+// Checks the magic, the version and the dimensions of a header read from a matrix file or a stream of them
+bool validMatrixHeader(const struct MatrixHeader* header) {
+    if (memcmp(header->magic, MATRIX_FILE_MAGIC, 8) != 0 || header->version != MATRIX_FILE_VERSION) return false;
+    return header->rows > 0 && header->cols > 0 && header->offset % MATRIX_FILE_ALIGNMENT == 0;
+}
+
+// Reads and validates the header of a matrix file
+int readMatrixHeader(const char* path, struct MatrixHeader* header) {
+    int fd = open(path, O_RDONLY);
+
+    if (fd == -1) return -1;
+
+    ssize_t bytes = pread(fd, header, sizeof(struct MatrixHeader), 0);
+    close(fd);
+
+    return bytes == sizeof(struct MatrixHeader) && validMatrixHeader(header) ? 0 : -1;
+}
+
+// Parses the command line arguments [dimensions] [repetitions] [threads], threads is NULL for sequential programs.
+// The dimensions can be replaced by --input FILE, which loads M from a matrix file, and --output FILE, anywhere in
+// the arguments, saves T in a matrix file. The workload class and the seed of the generated input matrix are read
+// from the WORKLOAD and SEED environment variables
+int parseArguments(int argc, char** argv, size_t* m, size_t* n, int* rep, int* threads) {
+    char* args[4] = {NULL, NULL, NULL, NULL};  // positional arguments
+    int count = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--output") == 0 && i + 1 < argc) {
+            outputFile = argv[++i];
+        } else if (strcmp(argv[i], "--input") == 0 && i + 1 < argc && count == 0) {
+            inputFile = argv[++i];
+            args[count++] = argv[i];
+        } else if (count < 4) {
+            args[count++] = argv[i];
+        }
+    }
+
+    struct MatrixHeader header;
+    if (inputFile != NULL) {
+        if (readMatrixHeader(inputFile, &header) == -1) {
+            printf("Invalid input file %s: not a matrix file\n\n", inputFile);
+            return -1;
+        }
+        *m = header.rows;
+        *n = header.cols;
+    }
+
+    if (count < 1 || (inputFile == NULL && parseDimensions(args[0], m, n) == -1)) {
+        printf("Correct usage: program-name [M dimensions as N or ROWSxCOLUMNS, or --input FILE] [number of repetitions (default 500)]");
+        printf("%s [--output FILE]\n\n", threads == NULL ? "" : " [number of threads (0 to run all cases)]");
+        return -1;
+    }
+
+    if (getenv("WORKLOAD") != NULL && parseWorkload(getenv("WORKLOAD"), &workload) == -1) {
+        printf("Invalid WORKLOAD: use random, symmetric, near or perturbed[:K[:early|middle|late]]\n\n");
+        return -1;
+    }
+    if (getenv("SEED") != NULL) workload.seed = strtoull(getenv("SEED"), NULL, 10);
+
+    *rep = count > 1 && atoi(args[1]) > 0 ? atoi(args[1]) : 500;
+    if (threads != NULL) *threads = count > 2 && atoi(args[2]) >= 0 ? atoi(args[2]) : 0;
+
+    return 0;
+}
+
+int saveResultsILP(const char* code, size_t m, size_t n, double flops, double bandwidth) {
     FILE* f = fopen(FILE_NAME_ILP, "a");
 
     if (f == NULL) return -1;
 
-    fprintf(f, "%s,%d,%.9f,%.9f\n", code, n, flops, bandwidth);
+    fprintf(f, "%s,%zu,%zu,%.9f,%.9f\n", code, m, n, flops, bandwidth);
     fclose(f);
 
     return 0;
 }
 
-int saveResultsOMP(const char* code, int n, int threads, double speedup1, double efficiency1, double speedup2, double efficiency2, double bandwidth) {
+int saveResultsOMP(const char* code, size_t m, size_t n, int threads, double speedup1, double efficiency1, double speedup2, double efficiency2, double bandwidth) {
     FILE* f = fopen(FILE_NAME_OMP, "a");
 
     if (f == NULL) return -1;
 
-    fprintf(f, "%s,%d,%d,%.9f,%.9f,%.9f,%.9f,%.9f\n", code, n, threads, speedup1, efficiency1, speedup2, efficiency2, bandwidth);
+    fprintf(f, "%s,%zu,%zu,%d,%.9f,%.9f,%.9f,%.9f,%.9f\n", code, m, n, threads, speedup1, efficiency1, speedup2, efficiency2, bandwidth);
+    fclose(f);
+
+    return 0;
+}
+
+int saveResultsEarlyExit(const char* code, size_t m, size_t n, int threads, double full, double rejection, double termination) {
+    FILE* f = fopen(FILE_NAME_EARLY_EXIT, "a");
+
+    if (f == NULL) return -1;
+
+    fprintf(f, "%s,%zu,%zu,%d,%.9f,%.9f,%.9f\n", code, m, n, threads, full, rejection, termination);
+    fclose(f);
+
+    return 0;
+}
+
+int saveResultsTLB(const char* code, size_t m, size_t n, int threads, long long check, long long transpose) {
+    FILE* f = fopen(FILE_NAME_TLB, "a");
+
+    if (f == NULL) return -1;
+
+    fprintf(f, "%s,%zu,%zu,%d,%lld,%lld\n", code, m, n, threads, check, transpose);
+    fclose(f);
+
+    return 0;
+}
+
+int saveResultsNUMA(const char* code, size_t m, size_t n, int threads, double local1, double remote1, double local2, double remote2) {
+    FILE* f = fopen(FILE_NAME_NUMA, "a");
+
+    if (f == NULL) return -1;
+
+    fprintf(f, "%s,%zu,%zu,%d,%.0f,%.0f,%.0f,%.0f\n", code, m, n, threads, local1, remote1, local2, remote2);
+    fclose(f);
+
+    return 0;
+}
+
+int saveResultsBatched(const char* code, size_t m, size_t n, int threads, size_t count, double check1, double transpose1, double check2, double transpose2) {
+    FILE* f = fopen(FILE_NAME_BATCHED, "a");
+
+    if (f == NULL) return -1;
+
+    fprintf(f, "%s,%zu,%zu,%d,%zu,%.3f,%.3f,%.3f,%.3f\n", code, m, n, threads, count, check1, transpose1, check2, transpose2);
+    fclose(f);
+
+    return 0;
+}
+
+int saveResultsForkJoin(const char* code, size_t m, size_t n, int threads, double fork_join, double check, double transpose) {
+    FILE* f = fopen(FILE_NAME_FORK_JOIN, "a");
+
+    if (f == NULL) return -1;
+
+    fprintf(f, "%s,%zu,%zu,%d,%.9f,%.9f,%.9f\n", code, m, n, threads, fork_join, check, transpose);
+    fclose(f);
+
+    return 0;
+}
+
+int saveResultsFused(const char* code, size_t m, size_t n, int threads, double separate, double fused, double bandwidth1, double bandwidth2) {
+    FILE* f = fopen(FILE_NAME_FUSED, "a");
+
+    if (f == NULL) return -1;
+
+    fprintf(f, "%s,%zu,%zu,%d,%.9f,%.9f,%.3f,%.3f\n", code, m, n, threads, separate, fused, bandwidth1, bandwidth2);
+    fclose(f);
+
+    return 0;
+}
+
+int saveResultsPacked(const char* code, size_t m, size_t n, int threads, const char* layout, double pack_verify, double pack, double unpack, double transpose,
+                      double bandwidth1, double bandwidth2) {
+    FILE* f = fopen(FILE_NAME_PACKED, "a");
+
+    if (f == NULL) return -1;
+
+    fprintf(f, "%s,%zu,%zu,%d,%s,%.9f,%.9f,%.9f,%.9f,%.3f,%.3f\n", code, m, n, threads, layout, pack_verify, pack, unpack, transpose, bandwidth1, bandwidth2);
+    fclose(f);
+
+    return 0;
+}
+
+int saveResultsOutOfCore(const char* code, size_t m, size_t n, int threads, size_t budget, double check, double transpose, double bandwidth1, double bandwidth2,
+                         double bandwidth3, double bandwidth4) {
+    FILE* f = fopen(FILE_NAME_OUT_OF_CORE, "a");
+
+    if (f == NULL) return -1;
+
+    fprintf(f, "%s,%zu,%zu,%d,%zu,%.9f,%.9f,%.3f,%.3f,%.3f,%.3f\n", code, m, n, threads, budget, check, transpose, bandwidth1, bandwidth2, bandwidth3, bandwidth4);
+    fclose(f);
+
+    return 0;
+}
+
+int saveResultsStreaming(const char* code, size_t m, size_t n, int threads, int buffers, size_t matrices, double time, double throughput, double bandwidth,
+                         double read_stall, double compute_stall, double write_stall) {
+    FILE* f = fopen(FILE_NAME_STREAMING, "a");
+
+    if (f == NULL) return -1;
+
+    fprintf(f, "%s,%zu,%zu,%d,%d,%zu,%.9f,%.3f,%.3f,%.9f,%.9f,%.9f\n", code, m, n, threads, buffers, matrices, time, throughput, bandwidth, read_stall, compute_stall,
+            write_stall);
+    fclose(f);
+
+    return 0;
+}
+
+int saveResultsFreivalds(const char* code, size_t m, size_t n, int threads, int trials, double exact, double filter, double filtered, double bandwidth1,
+                         double bandwidth2) {
+    FILE* f = fopen(FILE_NAME_FREIVALDS, "a");
+
+    if (f == NULL) return -1;
+
+    fprintf(f, "%s,%zu,%zu,%d,%d,%.9f,%.9f,%.9f,%.3f,%.3f\n", code, m, n, threads, trials, exact, filter, filtered, bandwidth1, bandwidth2);
+    fclose(f);
+
+    return 0;
+}
+
+int saveResultsTracked(const char* code, size_t m, size_t n, int threads, int updates, double checked, double full, double update, double tracked, double speedup) {
+    FILE* f = fopen(FILE_NAME_TRACKED, "a");
+
+    if (f == NULL) return -1;
+
+    fprintf(f, "%s,%zu,%zu,%d,%d,%.3f,%.9f,%.9f,%.9f,%.9f\n", code, m, n, threads, updates, checked, full, update, tracked, speedup);
+    fclose(f);
+
+    return 0;
+}
+
+int saveResultsTrackedTranspose(const char* code, size_t m, size_t n, int threads, size_t updates, double patched, double refreshed, double full,
+                                double refresh, double speedup) {
+    FILE* f = fopen(FILE_NAME_TRACKED_TRANSPOSE, "a");
+
+    if (f == NULL) return -1;
+
+    fprintf(f, "%s,%zu,%zu,%d,%zu,%.3f,%.3f,%.9f,%.9f,%.9f\n", code, m, n, threads, updates, patched, refreshed, full, refresh, speedup);
     fclose(f);
 
     return 0;
 }
 
-int initMatrices(double** M, double** T, int n) {
-    *M = (double*)malloc(n * n * sizeof(double));
-    *T = (double*)malloc(n * n * sizeof(double));
+// Allocates count elements of size bytes aligned to ALIGNMENT, that can be released with free. With -DHUGE_PAGES the
+// memory is backed by transparent huge pages (madvise is only a hint: 4 KiB pages are used when THP are disabled)
+void* allocElements(size_t count, size_t size) {
+    const size_t bytes = (count * size + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+    void* M;
+
+    if (posix_memalign(&M, ALIGNMENT, bytes) != 0) return NULL;
+
+#if defined(HUGE_PAGES)
+    madvise(M, bytes, MADV_HUGEPAGE);
+#endif
+
+    return M;
+}
+
+double* allocMatrix(size_t m, size_t n) {
+    return (double*)allocElements(m * n, sizeof(double));
+}
+
+// Reads (or writes, with out) bytes at offset of the file, repeating the partial transfers
+static inline int transferAll(int fd, void* buffer, size_t bytes, off_t offset, bool out) {
+    while (bytes > 0) {
+        ssize_t done = out ? pwrite(fd, buffer, bytes, offset) : pread(fd, buffer, bytes, offset);
+        if (done <= 0) return -1;
+        buffer = (char*)buffer + done;
+        bytes -= done;
+        offset += done;
+    }
+    return 0;
+}
+
+// Reads (or writes, with out) the payload of bytes at offset of the file at path in chunks of MATRIX_FILE_CHUNK, in
+// parallel with OpenMP. With -DDIRECT_IO the chunks aligned to disk blocks bypass the page cache through a second
+// descriptor opened with O_DIRECT, the others (or all of them, if the file system does not support it) are buffered.
+int transferPayload(const char* path, void* buffer, size_t bytes, off_t offset, bool out) {
+    const size_t chunks = (bytes + MATRIX_FILE_CHUNK - 1) / MATRIX_FILE_CHUNK;
+    int fd = open(path, out ? O_WRONLY : O_RDONLY);
+#if defined(DIRECT_IO)
+    int direct = open(path, (out ? O_WRONLY : O_RDONLY) | O_DIRECT);
+#else
+    int direct = -1;
+#endif
+    bool error = fd == -1;
+
+    OMP_PRAGMA(omp parallel for schedule(dynamic, 1) reduction(|| : error))
+    for (size_t c = 0; c < chunks; c++) {
+        char* start = (char*)buffer + c * MATRIX_FILE_CHUNK;
+        const size_t length = c * MATRIX_FILE_CHUNK + MATRIX_FILE_CHUNK < bytes ? MATRIX_FILE_CHUNK : bytes - c * MATRIX_FILE_CHUNK;
+        const bool aligned = (uintptr_t)start % MATRIX_FILE_ALIGNMENT == 0 && length % MATRIX_FILE_ALIGNMENT == 0;
+        if (!error) error = transferAll(direct != -1 && aligned ? direct : fd, start, length, offset + c * MATRIX_FILE_CHUNK, out) == -1;
+    }
+
+    if (out && fd != -1 && fdatasync(fd) == -1) error = true;  // the throughput includes the writes to the disk
+    if (direct != -1) close(direct);
+    if (fd != -1) close(fd);
+
+    return error ? -1 : 0;
+}
+
+// Loads the m x n matrix of the file at path into M and prints the load throughput. Only row-major double matrices
+// can be loaded, with any leading dimension (the padding of the rows is skipped)
+int loadMatrix(const char* path, double* M, size_t m, size_t n) {
+    struct MatrixHeader header;
+    struct timespec s, e;
+    int result = 0;
+
+    if (readMatrixHeader(path, &header) == -1 || header.rows != m || header.cols != n) return -1;
+    if (header.type != MATRIX_F64 || header.layout != MATRIX_ROW_MAJOR || header.element_size != sizeof(double) || header.ld < n) {
+        printf("Unsupported input file %s: only row-major double matrices can be loaded\n", path);
+        return -1;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &s);
+    if (header.ld == n) {
+        result = transferPayload(path, M, m * n * sizeof(double), header.offset, false);
+    } else {
+        int fd = open(path, O_RDONLY);
+        bool error = fd == -1;
+        OMP_PRAGMA(omp parallel for schedule(static) reduction(|| : error))
+        for (size_t i = 0; i < m; i++) {
+            if (!error) error = transferAll(fd, M + i * n, n * sizeof(double), header.offset + i * header.ld * sizeof(double), false) == -1;
+        }
+        if (fd != -1) close(fd);
+        result = error ? -1 : 0;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &e);
+
+    if (result == 0) printf("Loaded M from %s: %.3f GB in %.6f seconds (%.3f GB/s)\n\n", path, m * n * sizeof(double) * 1e-9, elapsedTime(s, e), m * n * sizeof(double) * 1e-9 / elapsedTime(s, e));
+    return result;
+}
+
+// Saves the m x n matrix M in the file at path, with a row-major payload without padding, and prints the save throughput
+int saveMatrix(const char* path, const double* M, size_t m, size_t n) {
+    struct MatrixHeader header = {MATRIX_FILE_MAGIC, MATRIX_FILE_VERSION, MATRIX_F64, MATRIX_ROW_MAJOR, sizeof(double), m, n, n, MATRIX_FILE_ALIGNMENT, 0};
+    struct timespec s, e;
+    const size_t bytes = m * n * sizeof(double);
 
-    if (*M == NULL || *T == NULL) {
+    clock_gettime(CLOCK_MONOTONIC, &s);
+    int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd == -1) return -1;
+    int result = transferAll(fd, &header, sizeof(header), 0, true) == -1 || ftruncate(fd, header.offset + bytes) == -1 ? -1 : 0;
+    close(fd);
+    if (result == 0) result = transferPayload(path, (void*)M, bytes, header.offset, true);
+    clock_gettime(CLOCK_MONOTONIC, &e);
+
+    if (result == 0) printf("Saved T in %s: %.3f GB in %.6f seconds (%.3f GB/s)\n\n", path, bytes * 1e-9, elapsedTime(s, e), bytes * 1e-9 / elapsedTime(s, e));
+    return result;
+}
+
+// Counters of the dTLB misses of loads and stores of the process, including the threads it creates after opening them
+struct TLBCounter {
+    int loads;
+    int stores;
+};
+
+int openPerfEvent(unsigned long long config) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HW_CACHE;
+    attr.config = config;
+    attr.disabled = 1;
+    attr.inherit = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+
+    return syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+// The counters are -1 when not available (e.g. restricted by perf_event_paranoid or on virtual machines)
+void openTLBCounter(struct TLBCounter* counter) {
+    counter->loads = openPerfEvent(PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+    counter->stores = openPerfEvent(PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_WRITE << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+}
+
+void startTLBCounter(const struct TLBCounter* counter) {
+    if (counter->loads != -1) {
+        ioctl(counter->loads, PERF_EVENT_IOC_RESET, 0);
+        ioctl(counter->loads, PERF_EVENT_IOC_ENABLE, 0);
+    }
+    if (counter->stores != -1) {
+        ioctl(counter->stores, PERF_EVENT_IOC_RESET, 0);
+        ioctl(counter->stores, PERF_EVENT_IOC_ENABLE, 0);
+    }
+}
+
+// Returns the dTLB misses since startTLBCounter averaged over rep repetitions, -1 if no counter is available
+long long stopTLBCounter(const struct TLBCounter* counter, int rep) {
+    long long misses = -1, value;
+
+    if (counter->loads != -1) {
+        ioctl(counter->loads, PERF_EVENT_IOC_DISABLE, 0);
+        if (read(counter->loads, &value, sizeof(value)) == sizeof(value)) misses = value;
+    }
+    if (counter->stores != -1) {
+        ioctl(counter->stores, PERF_EVENT_IOC_DISABLE, 0);
+        if (read(counter->stores, &value, sizeof(value)) == sizeof(value)) misses = misses == -1 ? value : misses + value;
+    }
+
+    return misses == -1 ? -1 : misses / rep;
+}
+
+void closeTLBCounter(const struct TLBCounter* counter) {
+    if (counter->loads != -1) close(counter->loads);
+    if (counter->stores != -1) close(counter->stores);
+}
+
+// Finalizer of splitmix64, a bijective mix of the bits of x
+static inline unsigned long long mix64(unsigned long long x) {
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+// Counter-based generator: the value of element (i, j) in [0, 1) only depends on the seed, its tile and its position
+// in the tile, so the tiles can be generated in any order and by any thread. stream selects independent sequences
+static inline double counterRandom(unsigned long long seed, size_t i, size_t j, unsigned long long stream) {
+    const unsigned long long tile = ((unsigned long long)(i / GENERATOR_TILE) << 32) ^ (j / GENERATOR_TILE);
+    const unsigned long long key = mix64(seed ^ mix64(tile ^ (stream << 62)));
+    return (mix64(key + (i % GENERATOR_TILE) * GENERATOR_TILE + j % GENERATOR_TILE) >> 11) * 0x1.0p-53;
+}
+
+// Position (i, j) of the p-th perturbation of an m x n matrix: the perturbations are placed in a window of consecutive
+// rows of the lower triangular part, starting from the first rows (early), the middle ones or the last ones (late),
+// each in a random column before the diagonal
+void perturbationPosition(const struct Workload* w, size_t p, size_t m, size_t n, size_t* i, size_t* j) {
+    const size_t window = w->perturbations < m - 1 ? w->perturbations : m - 1;
+    const size_t first = 1 + (size_t)(w->position * (m - 1 - window));
+    *i = first + p % window;
+    *j = (size_t)(counterRandom(w->seed, p, 0, 2) * (*i < n ? *i : n));
+}
+
+// Value of element (i, j) of the workload before the perturbations: the symmetric classes use the coordinates of the
+// lower triangular part for both mirrored elements
+static inline double workloadValue(const struct Workload* w, size_t i, size_t j) {
+    if (w->kind == WORKLOAD_RANDOM) return counterRandom(w->seed, i, j, 0) * 100;
+
+    double value = counterRandom(w->seed, i > j ? i : j, i > j ? j : i, 0) * 100;
+    if (w->kind == WORKLOAD_NEAR && i < j) value += (counterRandom(w->seed, i, j, 1) - 0.5) * EPSILON;
+
+    return value;
+}
+
+int initMatrix(double** M, size_t m, size_t n) {
+    *M = allocMatrix(m, n);
+
+    if (*M == NULL) return -1;
+
+    if (inputFile != NULL) {  // loaded instead of generated
+        if (loadMatrix(inputFile, *M, m, n) == 0) return 0;
+        printf("Error in loading %s!\n", inputFile);
         free(*M);
+        return -1;
+    }
+
+    // With OpenMP the tile rows are generated in parallel with the static distribution used by the kernels, so that
+    // every page is first touched, and placed on the NUMA node of, the thread that will process it
+    const size_t row_tiles = blockCount(m, GENERATOR_TILE);
+    const size_t col_tiles = blockCount(n, GENERATOR_TILE);
+    OMP_PRAGMA(omp parallel for schedule(static))
+    for (size_t rt = 0; rt < row_tiles; rt++) {
+        for (size_t ct = 0; ct < col_tiles; ct++) {
+            for (size_t i = rt * GENERATOR_TILE; i < rt * GENERATOR_TILE + blockLength(m, rt, GENERATOR_TILE); i++) {
+                for (size_t j = ct * GENERATOR_TILE; j < ct * GENERATOR_TILE + blockLength(n, ct, GENERATOR_TILE); j++) {
+                    (*M)[i * n + j] = workloadValue(&workload, i, j);
+                }
+            }
+        }
+    }
+
+    if (workload.kind == WORKLOAD_PERTURBED && m > 1) {
+        for (size_t p = 0; p < workload.perturbations; p++) {
+            size_t i, j;
+            perturbationPosition(&workload, p, m, n, &i, &j);
+            (*M)[i * n + j] += 1;
+        }
+    }
+
+    return 0;
+}
+
+int initMatrices(double** M, double** T, size_t m, size_t n) {
+    // T is aligned at least to a cache line, so that its rows can also be written with streaming stores
+    *T = allocMatrix(m, n);
+
+    if (*T == NULL || initMatrix(M, m, n) == -1) {
         free(*T);
         return -1;
     }
 
-    srand(time(0));
-    for (int i = 0; i < n; i++) {
-        for (int j = 0; j < n; j++) {
-            (*M)[i * n + j] = (double)rand() / RAND_MAX * 100;
+    // With OpenMP T is first touched in parallel like M, so that its pages are spread on the NUMA nodes of the
+    // threads. Sequential programs only touch it with -DPREFAULT, otherwise the first repetition pays the page faults
+#if defined(_OPENMP) || defined(PREFAULT)
+    OMP_PRAGMA(omp parallel for schedule(static))
+    for (size_t j = 0; j < n; j++) {
+        for (size_t i = 0; i < m; i++) {
+            (*T)[j * m + i] = 0;
         }
     }
+#endif
 
     return 0;
 }
 
-void testResults(double* M, double* T, int n) {
-    bool check = true;
-    bool transposed = true;
-    for (int i = 0; i < n; i++) {
-        for (int j = 0; j < n; j++) {
-            if (fabs(M[i * n + j] - M[j * n + i]) > EPSILON) {
-                check = false;
-            }
+// Side of the blocks compared by the verification, so that both matrices are read by cache-friendly tiles
+#define VERIFY_BLOCK 32
 
-            if (T[j * n + i] != M[i * n + j]) {
-                transposed = false;
+// Relative tolerance of the checksums, which only differ by the rounding errors of the summation order
+#define CHECKSUM_TOLERANCE 1e-10
+
+// Weighted checksums used to verify transpositions without comparing every element (or keeping a copy of M):
+// rows = sum(M[i][j] * i) and cols = sum(M[i][j] * j), transposing M swaps the two values
+void checksumMatrix(const double* M, size_t m, size_t n, double* rows, double* cols) {
+    double r = 0, c = 0;
+    OMP_PRAGMA(omp parallel for schedule(static) reduction(+ : r, c))
+    for (size_t i = 0; i < m; i++) {
+        for (size_t j = 0; j < n; j++) {
+            r += M[i * n + j] * i;
+            c += M[i * n + j] * j;
+        }
+    }
+    *rows = r;
+    *cols = c;
+}
+
+// Checks that the checksums a and b are equal up to the rounding errors of summing them in different orders
+bool checksumEqual(double a, double b) {
+    return fabs(a - b) <= CHECKSUM_TOLERANCE * fabs(a);
+}
+
+// Checks that the checksums of a square matrix (n x n) can belong to a symmetric one: rows - cols is the sum of
+// (M[i][j] - M[j][i]) * (i - j) over i > j, so differences below EPSILON can add up to EPSILON * (n^3 - n) / 6
+bool checksumSymmetric(double rows, double cols, size_t n) {
+    return fabs(rows - cols) <= EPSILON * ((double)n * n * n - n) / 6 + CHECKSUM_TOLERANCE * fabs(rows);
+}
+
+// Checks B (n x m) == transpose of A (m x n) within tolerance, comparing the matrices by blocks in parallel.
+// The symmetry of a square matrix M is isTransposeOf(M, M, n, n, EPSILON)
+bool isTransposeOf(const double* A, const double* B, size_t m, size_t n, double tolerance) {
+    const size_t row_blocks = blockCount(m, VERIFY_BLOCK);
+    const size_t col_blocks = blockCount(n, VERIFY_BLOCK);
+    bool equal = true;
+
+    OMP_PRAGMA(omp parallel for schedule(static) reduction(&& : equal))
+    for (size_t rb = 0; rb < row_blocks; rb++) {
+        for (size_t cb = 0; cb < col_blocks && equal; cb++) {  // the remaining blocks of the thread are skipped
+            const size_t rows = blockLength(m, rb, VERIFY_BLOCK);
+            const size_t cols = blockLength(n, cb, VERIFY_BLOCK);
+            const double* a = A + (rb * n + cb) * VERIFY_BLOCK;
+            const double* b = B + (cb * m + rb) * VERIFY_BLOCK;
+            for (size_t i = 0; i < rows; i++) {
+                for (size_t j = 0; j < cols; j++) {
+                    if (fabs(a[i * n + j] - b[j * m + i]) > tolerance) equal = false;
+                }
             }
         }
     }
 
-    printf("Tested results: symmetry %s and transposed %s.\n\n", check ? "true" : "false", transposed ? "correct" : "incorrect");
-}
\ No newline at end of file
+    return equal;
+}
+
+// The verification is selected with the VERIFY environment variable: full (default) compares every element,
+// checksum only compares the weighted checksums of M and T (which can miss some errors) and none skips it
+void testResults(double* M, double* T, size_t m, size_t n) {
+    const char* verify = getenv("VERIFY") != NULL ? getenv("VERIFY") : "full";
+
+    if (outputFile != NULL && saveMatrix(outputFile, T, n, m) == -1) printf("Error in saving T in %s!\n\n", outputFile);
+
+    if (strcmp(verify, "none") == 0) {
+        printf("Tested results: skipped.\n\n");
+        return;
+    }
+
+    // The checksums are always compared first, as they reject wrong transpositions at the cost of a streaming read
+    double mr, mc, tr, tc;
+    checksumMatrix(M, m, n, &mr, &mc);
+    checksumMatrix(T, n, m, &tr, &tc);
+    bool check = m == n && checksumSymmetric(mr, mc, n);  // only square matrices can be symmetric
+    bool transposed = checksumEqual(mr, tc) && checksumEqual(mc, tr);
+
+    if (strcmp(verify, "checksum") != 0) {
+        check = check && isTransposeOf(M, M, n, n, EPSILON);
+        transposed = transposed && isTransposeOf(M, T, m, n, 0);
+    }
+
+    printf("Tested results: symmetry %s and transposed %s%s.\n\n", check ? "true" : "false", transposed ? "correct" : "incorrect",
+           strcmp(verify, "checksum") == 0 ? " (checksums)" : "");
+}
+
+// Copy of M (n x n) kept by the in-place programs for the full verification of testInPlace, NULL when the VERIFY
+// environment variable selects the checksums or no verification (or the copy cannot be allocated)
+double* keepOriginal(const double* M, size_t n) {
+    const char* verify = getenv("VERIFY") != NULL ? getenv("VERIFY") : "full";
+    if (strcmp(verify, "checksum") == 0 || strcmp(verify, "none") == 0) return NULL;
+
+    double* original = allocMatrix(n, n);
+    if (original != NULL) memcpy(original, M, n * n * sizeof(double));
+    return original;
+}
+
+// Verifies M after in-place transpositions of the input matrix, selected like testResults by VERIFY: full compares
+// every element with original (the input kept by keepOriginal), transposed after an odd number of transpositions,
+// checksum only compares the weighted checksums with rows and cols, the ones of the input, and none skips it
+void testInPlace(const double* M, const double* original, size_t n, double rows, double cols, bool transposed) {
+    const char* verify = getenv("VERIFY") != NULL ? getenv("VERIFY") : "full";
+
+    // M holds its transpose only after an odd number of transpositions
+    if (outputFile != NULL && transposed && saveMatrix(outputFile, M, n, n) == -1) printf("Error in saving T in %s!\n\n", outputFile);
+    if (outputFile != NULL && !transposed) printf("T not saved: M was transposed an even number of times.\n\n");
+
+    if (strcmp(verify, "none") == 0) {
+        printf("Tested results: skipped.\n\n");
+        return;
+    }
+
+    // after an odd number of in-place transpositions the checksums are swapped
+    double r, c;
+    checksumMatrix(M, n, n, &r, &c);
+    double expectedRows = transposed ? cols : rows;
+    double expectedCols = transposed ? rows : cols;
+    bool correct = checksumEqual(expectedRows, r) && checksumEqual(expectedCols, c);
+
+    const bool full = original != NULL && strcmp(verify, "checksum") != 0;
+    if (full && correct) correct = transposed ? isTransposeOf(original, M, n, n, 0) : memcmp(original, M, n * n * sizeof(double)) == 0;
+    if (original == NULL && strcmp(verify, "checksum") != 0) printf("Error in allocating the copy of M, only the checksums are compared!\n");
+
+    printf("Tested results: in-place transposed %s%s.\n\n", correct ? "correct" : "incorrect", full ? "" : " (checksums)");
+}
@@ -0,0 +1,135 @@
+#include <immintrin.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "functions.h"
+
+#define CODE "IP"
+
+#define BLOCK_SIZE 32
+
+bool checkSymImp(const double* M, size_t m, size_t n) {
+    if (m != n) return false;  // only square matrices can be symmetric
+    const size_t size = BLOCK_SIZE < n ? BLOCK_SIZE : n;
+    const size_t blocks = blockCount(n, size);
+    bool check = true;
+
+    for (size_t rb = 0; rb < blocks; rb++) {                 // row blocks indexing
+        const size_t rows = blockLength(n, rb, size);        // edge blocks can be smaller
+        for (size_t cb = 0; cb <= rb; cb++) {                // column blocks indexing
+            const size_t cols = blockLength(n, cb, size);
+            const double* first = M + (rb * n + cb) * size;  // block matrix of lower triangular part
+            const double* last = M + (cb * n + rb) * size;   // block matrix of higher triangular part
+            for (size_t i = 0; i < rows; i++) {              // symmetry check
+                for (size_t j = 0; j < cols; j++) {
+                    if (fabs(first[i * n + j] - last[j * n + i]) > EPSILON) {
+                        check = false;
+                    }
+                }
+            }
+        }
+    }
+
+    return check;
+}
+
+void matTransposeInPlace(double* M, size_t n) {
+    const size_t size = BLOCK_SIZE < n ? BLOCK_SIZE : n;
+    const size_t blocks = blockCount(n, size);
+
+    for (size_t rb = 0; rb < blocks; rb++) {               // row blocks indexing
+        const size_t rows = blockLength(n, rb, size);      // edge blocks can be smaller
+        double* diagonal = M + (rb * n + rb) * size;       // block matrix on the main diagonal
+        for (size_t i = 1; i < rows; i++) {                // transposing the diagonal block in place
+            for (size_t j = 0; j < i; j++) {
+                double tmp = diagonal[i * n + j];
+                diagonal[i * n + j] = diagonal[j * n + i];
+                diagonal[j * n + i] = tmp;
+            }
+        }
+
+        for (size_t cb = 0; cb < rb; cb++) {               // column blocks indexing
+            const size_t cols = blockLength(n, cb, size);
+            double* first = M + (rb * n + cb) * size;      // block matrix of lower triangular part
+            double* last = M + (cb * n + rb) * size;       // block matrix of higher triangular part
+            for (size_t i = 0; i < rows; i++) {            // swapping the transposed blocks
+                for (size_t j = 0; j < cols; j++) {
+                    double tmp = first[i * n + j];
+                    first[i * n + j] = last[j * n + i];
+                    last[j * n + i] = tmp;
+                }
+            }
+        }
+    }
+}
+
+// The attribute is necessary to avoid the compiler optimization on the repetitions loops
+int __attribute__((optimize("O0"))) main(int argc, char** argv) {
+    size_t m = 0;
+    size_t n = 0;
+    int rep = 0;
+    if (parseArguments(argc, argv, &m, &n, &rep, NULL) == -1) {
+        return 1;
+    }
+
+    printf("Matrix dimensions: %zu x %zu\n\n", m, n);
+    printf("Repetitions: %d\n\n", rep);
+
+    if (m != n) {
+        printf("In-place transpose requires a square matrix!\n\n");
+        return 1;
+    }
+
+    // Variables declaration
+    struct timespec s1, s2, e1, e2;   // start, end times
+    double t1, t2, flops, bandwidth;  // execution times and performance metrics
+    double rows, cols;                // checksums of the input matrix
+    bool symmetric = false;           // symmetry check
+    double* M;                        // input matrix, transposed in place
+    double* original;                 // copy of the input matrix for the verification
+
+    // Matrix allocation (no T buffer is needed)
+    if (initMatrix(&M, m, n) == -1) {
+        printf("Error in allocating matrices!\n\n");
+        return -1;
+    }
+    checksumMatrix(M, n, n, &rows, &cols);
+    original = keepOriginal(M, n);
+
+    // Execution
+    clock_gettime(CLOCK_MONOTONIC, &s1);
+    for (int i = 0; i < rep; i++) symmetric = checkSymImp(M, m, n);
+    clock_gettime(CLOCK_MONOTONIC, &e1);
+
+    clock_gettime(CLOCK_MONOTONIC, &s2);
+    for (int i = 0; i < rep; i++) matTransposeInPlace(M, n);
+    clock_gettime(CLOCK_MONOTONIC, &e2);
+    // --------------------------------
+
+    // Results printing and saving
+    t1 = elapsedTime(s1, e1) / rep;
+    t2 = elapsedTime(s2, e2) / rep;
+
+    const size_t size = BLOCK_SIZE < n ? BLOCK_SIZE : n;
+    flops = (double)n * (n + size) / 2 / t1;
+    bandwidth = (double)(2 * m * n * sizeof(double)) / t2;
+
+    printf("Sequential execution: symmetry: %s\n", symmetric ? "true" : "false");
+    printf("checkSym:\t%.9f seconds\t%10.4g GFLOPS\n", t1, flops * 1e-9);
+    printf("matTranspose:\t%.9f seconds\t%10.4g GB/s\n\n", t2, bandwidth * 1e-9);
+
+    testInPlace(M, original, n, rows, cols, rep % 2 == 1);
+
+    if (saveResultsILP(CODE, m, n, flops, bandwidth) == -1) {
+        printf("Error in saving results!\n\n");
+    }
+
+    // Matrix deallocation
+    free(M);
+    free(original);
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,103 @@
+#include <immintrin.h>
+#include <math.h>
+#include <omp.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "functions.h"
+#include "dispatch.h"
+
+#define CODE "OAD"
+
+// The attribute is necessary to avoid the compiler optimization on the repetitions loops
+int __attribute__((optimize("O0"))) main(int argc, char** argv) {
+#ifdef _OPENMP
+    printf("Compiled with OpenMP %d.%02d\n", _OPENMP / 100, _OPENMP % 100);
+#else
+    printf("Error: compile with -fopenmp flag");
+#endif
+
+    size_t m = 0;
+    size_t n = 0;
+    int rep = 0;
+    int threads = 0;
+    if (parseArguments(argc, argv, &m, &n, &rep, &threads) == -1) {
+        return 1;
+    }
+
+    printf("Matrix dimensions: %zu x %zu\n", m, n);
+    printf("Repetitions: %d\n", rep);
+    printf("Available cores: %d\n\n", omp_get_num_procs());
+
+    // Variables declaration
+    double ts1, ts2, te1, te2, t1, t2, s1 = 0, s2 = 0;  // execution times
+    bool symmetric = false;                             // symmetry check
+    double* M;                                          // input matrix
+    double* T;                                          // transposed matrix
+    struct DispatchOptions options = {1, true};         // the missing size classes are calibrated
+    struct Dispatch check_choice, transpose_choice;     // choices of the dispatcher
+
+    // Matrices allocation
+    if (initMatrices(&M, &T, m, n) == -1) {
+        printf("Error in allocating matrices!\n\n");
+        return -1;
+    }
+
+    printf("Results: maximum threads (T), symmetry (S), ");
+    printf("symmetry speedup (SS), symmetry efficiency (SE), transpose speedup (TS), transpose efficiency (TE), transpose bandwidth in GB/s (TB), ");
+    printf("threads chosen for symmetry (CS) and transpose (CT), speedups over the sequential kernel\n\n");
+    printf("\t|\tT\t|\tS\t|\tSS\t|\tSE\t|\tTS\t|\tTE\t|\tTB\t|\tCS\t|\tCT\t|\n");
+
+    // Executions, 1 thread is the sequential kernel
+    for (int i = nextThreads(0, threads, true); i != 0; i = nextThreads(i, threads, true)) {  // the sequential and the passed threads
+        options.threads = i;
+
+        // Choices, with the calibration of the size class outside of the timings
+        check_choice = chooseDispatch(ROUTINE_CHECK, M, NULL, m, n, &options);
+        transpose_choice = chooseDispatch(ROUTINE_TRANSPOSE, M, T, m, n, &options);
+
+        ts1 = omp_get_wtime();
+        for (int j = 0; j < rep; j++) symmetric = checkSymAdaptive(M, m, n, &options);
+        te1 = omp_get_wtime();
+
+        ts2 = omp_get_wtime();
+        for (int j = 0; j < rep; j++) matTransposeAdaptive(M, T, m, n, &options);
+        te2 = omp_get_wtime();
+
+        // Results printing and saving
+        t1 = (te1 - ts1) / rep;
+        t2 = (te2 - ts2) / rep;
+        if (i == 1) {
+            s1 = t1;
+            s2 = t2;
+        }
+
+        double speedup1 = (double)s1 / t1;
+        double efficiency1 = (double)speedup1 / i * 100;
+        double speedup2 = (double)s2 / t2;
+        double efficiency2 = (double)speedup2 / i * 100;
+        double bandwidth = 2 * m * n * sizeof(double) / (t2);
+
+        printf("\t| %d\t\t| %d\t\t| %8.4f\t| %8.4f\t| %8.4f\t| %8.4f\t| %8.4f\t| %d\t\t| %d\t\t|\n", i, symmetric, speedup1, efficiency1, speedup2, efficiency2, bandwidth * 1e-9,
+               check_choice.threads, transpose_choice.threads);
+
+        if (saveResultsOMP(CODE, m, n, i, speedup1, efficiency1, speedup2, efficiency2, bandwidth) == -1) {
+            printf("Error in saving results!\n\n");
+        }
+    }
+    // --------------------------------
+
+    printf("\n");
+    printDispatch("checkSymAdaptive", &check_choice);
+    printDispatch("matTransposeAdaptive", &transpose_choice);
+    printf("\n");
+    testResults(M, T, m, n);
+
+    // Matrices deallocation
+    free(M);
+    free(T);
+
+    return 0;
+}
\ No newline at end of file
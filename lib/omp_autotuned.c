@@ -0,0 +1,142 @@
+#include <immintrin.h>
+#include <math.h>
+#include <omp.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "functions.h"
+#include "tuning.h"
+
+#define CODE "OAT"
+
+// The attribute is necessary to avoid the compiler optimization on the repetitions loops
+int __attribute__((optimize("O0"))) main(int argc, char** argv) {
+#ifdef _OPENMP
+    printf("Compiled with OpenMP %d.%02d\n", _OPENMP / 100, _OPENMP % 100);
+#else
+    printf("Error: compile with -fopenmp flag");
+#endif
+
+    size_t m = 0;
+    size_t n = 0;
+    int rep = 0;
+    int threads = 0;
+    if (parseArguments(argc, argv, &m, &n, &rep, &threads) == -1) {
+        return 1;
+    }
+
+    printf("Matrix dimensions: %zu x %zu\n", m, n);
+    printf("Repetitions: %d\n\n", rep);
+
+    // Profiles loading, produced by autotune.o for this CPU
+    struct Profile check_profile, transpose_profile;
+    printProfile("checkSymOMP", &check_profile, loadProfile("checkSymOMP", m, n, &check_profile));
+    printProfile("matTransposeOMP", &transpose_profile, loadProfile("matTransposeOMP", m, n, &transpose_profile));
+    printf("\n");
+
+    // Variables declaration
+    double ts1, ts2, te1, te2, t1, t2, s1, s2;  // execution times
+    bool symmetric = false;                     // symmetry check
+    double* M;                                  // input matrix
+    double* T;                                  // transposed matrix
+
+    // Matrices allocation
+    if (initMatrices(&M, &T, m, n) == -1) {
+        printf("Error in allocating matrices!\n\n");
+        return -1;
+    }
+
+    omp_set_num_threads(1);
+
+    ts1 = omp_get_wtime();
+    for (int i = 0; i < rep; i++) symmetric = checkSymTunedOMP(M, m, n, &check_profile);
+    te1 = omp_get_wtime();
+
+    ts2 = omp_get_wtime();
+    for (int i = 0; i < rep; i++) matTransposeTunedOMP(M, T, m, n, &transpose_profile);
+    te2 = omp_get_wtime();
+
+    s1 = (te1 - ts1) / rep;
+    s2 = (te2 - ts2) / rep;
+
+    printf("Sequential execution: symmetry: %s\n", symmetric ? "true" : "false");
+    printf("checkSymTunedOMP:\t%.9f seconds\n", s1);
+    printf("matTransposeTunedOMP:\t%.9f seconds\n\n", s2);
+
+    printf("Results: threads (T), symmetry (S), ");
+    printf("symmetry speedup (SS), symmetry efficiency (SE), transpose speedup (TS), transpose efficiency (TE), transpose bandwidth in GB/s (TB) \n\n");
+    printf("\t|\tT\t|\tS\t|\tSS\t|\tSE\t|\tTS\t|\tTE\t|\tTB\t|\n");
+    
+    double bandwidth = 2 * m * n * sizeof(double) / (s2);
+    if (saveResultsOMP(CODE, m, n, 1, 1, 100, 1, 100, bandwidth) == -1) {
+        printf("Error in saving results!\n\n");
+    }
+
+    // Executions
+    if (threads == 0) {
+        for (int i = 2; i <= 64; i *= 2) {
+            omp_set_num_threads(i);
+
+            ts1 = omp_get_wtime();
+            for (int j = 0; j < rep; j++) symmetric = checkSymTunedOMP(M, m, n, &check_profile);
+            te1 = omp_get_wtime();
+
+            ts2 = omp_get_wtime();
+            for (int j = 0; j < rep; j++) matTransposeTunedOMP(M, T, m, n, &transpose_profile);
+            te2 = omp_get_wtime();
+
+            // Results printing and saving
+            t1 = (te1 - ts1) / rep;
+            t2 = (te2 - ts2) / rep;
+
+            double speedup1 = (double)s1 / t1;
+            double efficiency1 = (double)speedup1 / i * 100;
+            double speedup2 = (double)s2 / t2;
+            double efficiency2 = (double)speedup2 / i * 100;
+            double bandwidth = 2 * m * n * sizeof(double) / (t2);
+
+            printf("\t| %d\t\t| %d\t\t| %8.4f\t| %8.4f\t| %8.4f\t| %8.4f\t| %8.4f\t|\n", i, symmetric, speedup1, efficiency1, speedup2, efficiency2, bandwidth * 1e-9);
+
+            if (saveResultsOMP(CODE, m, n, i, speedup1, efficiency1, speedup2, efficiency2, bandwidth) == -1) {
+                printf("Error in saving results!\n\n");
+            }
+        }
+    } else {
+        omp_set_num_threads(threads);
+        ts1 = omp_get_wtime();
+        for (int j = 0; j < rep; j++) symmetric = checkSymTunedOMP(M, m, n, &check_profile);
+        te1 = omp_get_wtime();
+
+        ts2 = omp_get_wtime();
+        for (int j = 0; j < rep; j++) matTransposeTunedOMP(M, T, m, n, &transpose_profile);
+        te2 = omp_get_wtime();
+
+        // Results printing and saving
+        t1 = (te1 - ts1) / rep;
+        t2 = (te2 - ts2) / rep;
+
+        double speedup1 = (double)s1 / t1;
+        double efficiency1 = (double)speedup1 / threads * 100;
+        double speedup2 = (double)s2 / t2;
+        double efficiency2 = (double)speedup2 / threads * 100;
+        double bandwidth = 2 * m * n * sizeof(double) / (t2);
+
+        printf("\t| %d\t\t| %d\t\t| %8.4f\t| %8.4f\t| %8.4f\t| %8.4f\t| %8.4f\t|\n", threads, symmetric, speedup1, efficiency1, speedup2, efficiency2, bandwidth);
+
+        if (saveResultsOMP(CODE, m, n, threads, speedup1, efficiency1, speedup2, efficiency2, bandwidth) == -1) {
+            printf("Error in saving results!\n\n");
+        }
+    }
+    // --------------------------------
+
+    printf("\n");
+    testResults(M, T, m, n);
+
+    // Matrices deallocation
+    free(M);
+    free(T);
+
+    return 0;
+}
\ No newline at end of file
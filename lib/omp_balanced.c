@@ -0,0 +1,275 @@
+#include <immintrin.h>
+#include <math.h>
+#include <omp.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "functions.h"
+#include "simd.h"
+
+#if defined(WORK_STEALING)
+#define CODE "OB_BW"
+#else
+#define CODE "OB_B"
+#endif
+
+#define BLOCK_SIZE 32
+
+// Work units (blocks for the transpose) claimed at a time from a range with work stealing
+#ifndef STEAL_CHUNK
+#define STEAL_CHUNK 64
+#endif
+
+// The lower triangular part is measured in work units: a pair of mirrored blocks reads two blocks (2 units) and a
+// diagonal block only one (1 unit), so the blocks of the rows before rb add up to rb^2 units and the first unit of
+// the block (rb, cb) is rb^2 + 2 * cb. Each thread gets a contiguous range of units with the same size and checks
+// the blocks starting inside it.
+
+// First block starting at or after the unit u of the lower triangular part
+static inline void triangularBlock(size_t u, size_t* rb, size_t* cb) {
+    size_t r = (size_t)sqrt((double)u);
+    while (r * r > u) r--;  // rounding of sqrt on large units
+    while ((r + 1) * (r + 1) <= u) r++;
+    *rb = r;
+    *cb = (u - r * r + 1) / 2;  // a unit in the middle of a pair moves to the next block
+    if (*cb > r) {
+        (*rb)++;
+        *cb = 0;
+    }
+}
+
+// Checks the blocks starting in the units [begin, end), decoding the first block once and then incrementing
+static inline bool checkRange(const double* M, size_t n, size_t size, size_t begin, size_t end) {
+    size_t rb, cb;
+    bool check = true;
+
+    triangularBlock(begin, &rb, &cb);
+    for (size_t u = rb * rb + 2 * cb; u < end;) {
+        const double* first = M + (rb * n + cb) * size;  // block matrix of lower triangular part
+        const double* last = M + (cb * n + rb) * size;   // block matrix of higher triangular part
+        check &= checkBlock(first, last, n, blockLength(n, rb, size), blockLength(n, cb, size), rb == cb);
+        if (cb == rb) {  // next row of blocks after the diagonal block
+            u += 1;
+            rb++;
+            cb = 0;
+        } else {
+            u += 2;
+            cb++;
+        }
+    }
+
+    return check;
+}
+
+// Transposes the blocks [begin, end) of the row-major grid of blocks, decoding the first block once and then incrementing
+static inline void transposeRange(const double* M, double* T, size_t m, size_t n, size_t size, size_t begin, size_t end) {
+    const size_t col_blocks = blockCount(n, size);
+    size_t rb = begin / col_blocks;
+    size_t cb = begin % col_blocks;
+
+    for (size_t b = begin; b < end; b++) {
+        const double* source = M + (rb * n + cb) * size;  // block (rb, cb) of M
+        double* destination = T + (cb * m + rb) * size;   // block (cb, rb) of T, where it is transposed
+        transposeBlock(source, n, destination, m, blockLength(m, rb, size), blockLength(n, cb, size));
+        if (++cb == col_blocks) {  // next row of blocks
+            rb++;
+            cb = 0;
+        }
+    }
+}
+
+#ifdef WORK_STEALING
+// Range of a thread, on its own cache line since the other threads steal from it
+struct Range {
+    size_t next;
+    size_t end;
+    char padding[64 - 2 * sizeof(size_t)];
+};
+
+// Claims the next chunk of units of a range, false when the range is finished
+static inline bool claimChunk(struct Range* range, size_t* begin, size_t* end) {
+    size_t next;
+#pragma omp atomic capture
+    {
+        next = range->next;
+        range->next += STEAL_CHUNK;
+    }
+    if (next >= range->end) return false;
+
+    *begin = next;
+    *end = next + STEAL_CHUNK < range->end ? next + STEAL_CHUNK : range->end;
+    return true;
+}
+
+// Next chunk of thread t: from its own range, then from the ranges of the following threads once it is finished
+static inline bool nextChunk(struct Range* ranges, int t, int threads, size_t* begin, size_t* end) {
+    for (int v = 0; v < threads; v++) {
+        if (claimChunk(&ranges[(t + v) % threads], begin, end)) return true;
+    }
+    return false;
+}
+#endif
+
+bool checkSymOMP(const double* M, size_t m, size_t n) {
+    if (m != n) return false;  // only square matrices can be symmetric
+    const size_t size = BLOCK_SIZE < n ? BLOCK_SIZE : n / omp_get_num_threads();
+    const size_t blocks = blockCount(n, size);
+    const size_t units = blocks * blocks;  // work units of the lower triangular part
+    bool check = true;
+#ifdef WORK_STEALING
+    struct Range* ranges = aligned_alloc(64, omp_get_max_threads() * sizeof(struct Range));
+#endif
+
+#pragma omp parallel reduction(&& : check)
+    {
+        const int t = omp_get_thread_num();
+        const int threads = omp_get_num_threads();
+        size_t begin = units * t / threads;  // contiguous range with the same work
+        size_t end = units * (t + 1) / threads;
+        bool c = true;
+
+#ifdef WORK_STEALING
+        ranges[t].next = begin;
+        ranges[t].end = end;
+#pragma omp barrier
+        while (nextChunk(ranges, t, threads, &begin, &end)) c &= checkRange(M, n, size, begin, end);
+#else
+        c = checkRange(M, n, size, begin, end);
+#endif
+
+        check = check && c;
+    }
+
+#ifdef WORK_STEALING
+    free(ranges);
+#endif
+    return check;
+}
+
+void matTransposeOMP(const double* M, double* T, size_t m, size_t n) {
+    const size_t size = BLOCK_SIZE < n ? BLOCK_SIZE : n / omp_get_num_threads();
+    const size_t blocks = blockCount(m, size) * blockCount(n, size);
+#ifdef WORK_STEALING
+    struct Range* ranges = aligned_alloc(64, omp_get_max_threads() * sizeof(struct Range));
+#endif
+
+#pragma omp parallel
+    {
+        const int t = omp_get_thread_num();
+        const int threads = omp_get_num_threads();
+        size_t begin = blocks * t / threads;  // contiguous range with the same number of blocks
+        size_t end = blocks * (t + 1) / threads;
+
+#ifdef WORK_STEALING
+        ranges[t].next = begin;
+        ranges[t].end = end;
+#pragma omp barrier
+        while (nextChunk(ranges, t, threads, &begin, &end)) transposeRange(M, T, m, n, size, begin, end);
+#else
+        transposeRange(M, T, m, n, size, begin, end);
+#endif
+    }
+
+#ifdef WORK_STEALING
+    free(ranges);
+#endif
+}
+
+// The attribute is necessary to avoid the compiler optimization on the repetitions loops
+int __attribute__((optimize("O0"))) main(int argc, char** argv) {
+#ifdef _OPENMP
+    printf("Compiled with OpenMP %d.%02d\n", _OPENMP / 100, _OPENMP % 100);
+#else
+    printf("Error: compile with -fopenmp flag");
+#endif
+
+    size_t m = 0;
+    size_t n = 0;
+    int rep = 0;
+    int threads = 0;
+    if (parseArguments(argc, argv, &m, &n, &rep, &threads) == -1) {
+        return 1;
+    }
+
+    printf("Matrix dimensions: %zu x %zu\n", m, n);
+    printf("Repetitions: %d\n\n", rep);
+
+    // Variables declaration
+    double ts1, ts2, te1, te2, t1, t2, s1, s2;  // execution times
+    bool symmetric = false;                     // symmetry check
+    double* M;                                  // input matrix
+    double* T;                                  // transposed matrix
+
+    // Matrices allocation
+    if (initMatrices(&M, &T, m, n) == -1) {
+        printf("Error in allocating matrices!\n\n");
+        return -1;
+    }
+
+    omp_set_num_threads(1);
+
+    ts1 = omp_get_wtime();
+    for (int i = 0; i < rep; i++) symmetric = checkSymOMP(M, m, n);
+    te1 = omp_get_wtime();
+
+    ts2 = omp_get_wtime();
+    for (int i = 0; i < rep; i++) matTransposeOMP(M, T, m, n);
+    te2 = omp_get_wtime();
+
+    s1 = (te1 - ts1) / rep;
+    s2 = (te2 - ts2) / rep;
+
+    printf("Sequential execution: symmetry: %s\n", symmetric ? "true" : "false");
+    printf("checkSymOMP:\t%.9f seconds\n", s1);
+    printf("matTransposeOMP:%.9f seconds\n\n", s2);
+
+    printf("Results: threads (T), symmetry (S), ");
+    printf("symmetry speedup (SS), symmetry efficiency (SE), transpose speedup (TS), transpose efficiency (TE), transpose bandwidth in GB/s (TB) \n\n");
+    printf("\t|\tT\t|\tS\t|\tSS\t|\tSE\t|\tTS\t|\tTE\t|\tTB\t|\n");
+    
+    double bandwidth = 2 * m * n * sizeof(double) / (s2);
+    if (saveResultsOMP(CODE, m, n, 1, 1, 100, 1, 100, bandwidth) == -1) {
+        printf("Error in saving results!\n\n");
+    }
+
+    // Executions
+    for (int i = nextThreads(0, threads, false); i != 0; i = nextThreads(i, threads, false)) {  // the passed threads
+        omp_set_num_threads(i);
+
+        ts1 = omp_get_wtime();
+        for (int j = 0; j < rep; j++) symmetric = checkSymOMP(M, m, n);
+        te1 = omp_get_wtime();
+
+        ts2 = omp_get_wtime();
+        for (int j = 0; j < rep; j++) matTransposeOMP(M, T, m, n);
+        te2 = omp_get_wtime();
+
+        // Results printing and saving
+        t1 = (te1 - ts1) / rep;
+        t2 = (te2 - ts2) / rep;
+
+        double speedup1 = (double)s1 / t1;
+        double efficiency1 = (double)speedup1 / i * 100;
+        double speedup2 = (double)s2 / t2;
+        double efficiency2 = (double)speedup2 / i * 100;
+        double bandwidth = 2 * m * n * sizeof(double) / (t2);
+
+        printf("\t| %d\t\t| %d\t\t| %8.4f\t| %8.4f\t| %8.4f\t| %8.4f\t| %8.4f\t|\n", i, symmetric, speedup1, efficiency1, speedup2, efficiency2, bandwidth * 1e-9);
+
+        if (saveResultsOMP(CODE, m, n, i, speedup1, efficiency1, speedup2, efficiency2, bandwidth) == -1) {
+            printf("Error in saving results!\n\n");
+        }
+    }
+    // --------------------------------
+
+    printf("\n");
+    testResults(M, T, m, n);
+
+    // Matrices deallocation
+    free(M);
+    free(T);
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,266 @@
+#include <immintrin.h>
+#include <math.h>
+#include <omp.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "functions.h"
+#include "simd.h"
+
+#define CODE "OBA"
+
+#define BLOCK_SIZE 32
+
+// Total elements of the batch, split into matrices with sides between half and the whole of the passed dimensions
+#ifndef BATCH_ELEMENTS
+#define BATCH_ELEMENTS (1UL << 22)
+#endif
+
+// Matrices assigned to a thread at a time by the dynamic schedule of the batched kernels
+#define BATCH_CHUNK 16
+
+// Sequential blocked kernels with register tiles, used on each matrix of the batch
+bool checkSymMatrix(const double* M, size_t m, size_t n) {
+    if (m != n) return false;  // only square matrices can be symmetric
+    const size_t size = BLOCK_SIZE < n ? BLOCK_SIZE : n;
+    const size_t blocks = blockCount(n, size);
+    bool check = true;
+
+    for (size_t rb = 0; rb < blocks; rb++) {                 // row blocks indexing
+        for (size_t cb = 0; cb <= rb; cb++) {                // column blocks indexing
+            const double* first = M + (rb * n + cb) * size;  // block matrix of lower triangular part
+            const double* last = M + (cb * n + rb) * size;   // block matrix of higher triangular part
+            check &= checkBlock(first, last, n, blockLength(n, rb, size), blockLength(n, cb, size), rb == cb);
+        }
+    }
+
+    return check;
+}
+
+void matTransposeMatrix(const double* M, double* T, size_t m, size_t n) {
+    const size_t size = BLOCK_SIZE < n ? BLOCK_SIZE : n;
+    const size_t row_blocks = blockCount(m, size);
+    const size_t col_blocks = blockCount(n, size);
+
+    for (size_t rb = 0; rb < row_blocks; rb++) {      // row blocks indexing
+        for (size_t cb = 0; cb < col_blocks; cb++) {  // column blocks indexing
+            transposeBlock(M + (rb * n + cb) * size, n, T + (cb * m + rb) * size, m, blockLength(m, rb, size), blockLength(n, cb, size));
+        }
+    }
+}
+
+// Parallel kernels of OBV, which fork a team for every matrix: the baseline of the batched ones
+bool checkSymOMP(const double* M, size_t m, size_t n) {
+    if (m != n) return false;  // only square matrices can be symmetric
+    const size_t size = BLOCK_SIZE < n ? BLOCK_SIZE : n;
+    const size_t blocks = blockCount(n, size);
+    bool check = true;
+
+#pragma omp parallel for reduction(&& : check)
+    for (size_t rb = 0; rb < blocks; rb++) {                 // row blocks indexing
+        for (size_t cb = 0; cb <= rb; cb++) {                // column blocks indexing
+            const double* first = M + (rb * n + cb) * size;  // block matrix of lower triangular part
+            const double* last = M + (cb * n + rb) * size;   // block matrix of higher triangular part
+            check &= checkBlock(first, last, n, blockLength(n, rb, size), blockLength(n, cb, size), rb == cb);
+        }
+    }
+
+    return check;
+}
+
+void matTransposeOMP(const double* M, double* T, size_t m, size_t n) {
+    const size_t size = BLOCK_SIZE < n ? BLOCK_SIZE : n;
+    const size_t row_blocks = blockCount(m, size);
+    const size_t col_blocks = blockCount(n, size);
+
+#pragma omp parallel for collapse(2)
+    for (size_t rb = 0; rb < row_blocks; rb++) {      // row blocks indexing
+        for (size_t cb = 0; cb < col_blocks; cb++) {  // column blocks indexing
+            transposeBlock(M + (rb * n + cb) * size, n, T + (cb * m + rb) * size, m, blockLength(m, rb, size), blockLength(n, cb, size));
+        }
+    }
+}
+
+// Batched kernels: one parallel region for the whole batch of count matrices, the k-th with m[k] rows and n[k]
+// columns. The matrices are distributed among the threads, with a dynamic schedule since their sizes differ,
+// and each one is processed by a single thread with the sequential kernel.
+void checkSymBatched(const double* const* M, const size_t* m, const size_t* n, size_t count, bool* symmetric) {
+#pragma omp parallel for schedule(dynamic, BATCH_CHUNK)
+    for (size_t k = 0; k < count; k++) symmetric[k] = checkSymMatrix(M[k], m[k], n[k]);
+}
+
+void matTransposeBatched(const double* const* M, double* const* T, const size_t* m, const size_t* n, size_t count) {
+#pragma omp parallel for schedule(dynamic, BATCH_CHUNK)
+    for (size_t k = 0; k < count; k++) matTransposeMatrix(M[k], T[k], m[k], n[k]);
+}
+
+// Allocates a batch of about BATCH_ELEMENTS elements of matrices with random dimensions between half and the whole of
+// rows x cols (square when rows == cols), stored one after the other in a single buffer with every matrix aligned to
+// a cache line. Every matrix is generated with the workload class and the seed incremented by its index.
+size_t initBatch(double*** M, double*** T, size_t** m, size_t** n, size_t rows, size_t cols) {
+    const size_t average = (rows - rows / 4) * (cols - cols / 4);
+    const size_t count = BATCH_ELEMENTS / average > 0 ? BATCH_ELEMENTS / average : 1;
+    size_t* offset = (size_t*)malloc((count + 1) * sizeof(size_t));
+
+    *m = (size_t*)malloc(count * sizeof(size_t));
+    *n = (size_t*)malloc(count * sizeof(size_t));
+    *M = (double**)malloc(count * sizeof(double*));
+    *T = (double**)malloc(count * sizeof(double*));
+    if (offset == NULL || *m == NULL || *n == NULL || *M == NULL || *T == NULL) {
+        free(offset);
+        free(*m);
+        free(*n);
+        free(*M);
+        free(*T);
+        return 0;
+    }
+
+    offset[0] = 0;
+    for (size_t k = 0; k < count; k++) {
+        (*m)[k] = rows / 2 + (size_t)(counterRandom(workload.seed, k, 0, 4) * (rows - rows / 2 + 1));
+        (*n)[k] = rows == cols ? (*m)[k] : cols / 2 + (size_t)(counterRandom(workload.seed, k, 1, 4) * (cols - cols / 2 + 1));
+        if ((*m)[k] == 0) (*m)[k] = 1;
+        if ((*n)[k] == 0) (*n)[k] = 1;
+        offset[k + 1] = offset[k] + ((*m)[k] * (*n)[k] + 7) / 8 * 8;  // 8 doubles per cache line
+    }
+
+    double* bufferM = allocMatrix(offset[count], 1);
+    double* bufferT = allocMatrix(offset[count], 1);
+    if (bufferM == NULL || bufferT == NULL) {
+        free(bufferM);
+        free(bufferT);
+        free(offset);
+        free(*m);
+        free(*n);
+        free(*M);
+        free(*T);
+        return 0;
+    }
+
+#pragma omp parallel for schedule(dynamic, BATCH_CHUNK)
+    for (size_t k = 0; k < count; k++) {
+        struct Workload w = workload;
+        w.seed += k;
+
+        (*M)[k] = bufferM + offset[k];
+        (*T)[k] = bufferT + offset[k];
+        for (size_t i = 0; i < (*m)[k]; i++) {
+            for (size_t j = 0; j < (*n)[k]; j++) {
+                (*M)[k][i * (*n)[k] + j] = workloadValue(&w, i, j);
+                (*T)[k][i * (*n)[k] + j] = 0;
+            }
+        }
+        for (size_t p = 0; w.kind == WORKLOAD_PERTURBED && (*m)[k] > 1 && p < w.perturbations; p++) {
+            size_t i, j;
+            perturbationPosition(&w, p, (*m)[k], (*n)[k], &i, &j);
+            (*M)[k][i * (*n)[k] + j] += 1;
+        }
+    }
+
+    free(offset);
+    return count;
+}
+
+// The attribute is necessary to avoid the compiler optimization on the repetitions loops
+int __attribute__((optimize("O0"))) main(int argc, char** argv) {
+#ifdef _OPENMP
+    printf("Compiled with OpenMP %d.%02d\n", _OPENMP / 100, _OPENMP % 100);
+#else
+    printf("Error: compile with -fopenmp flag");
+#endif
+
+    size_t m = 0;
+    size_t n = 0;
+    int rep = 0;
+    int threads = 0;
+    if (parseArguments(argc, argv, &m, &n, &rep, &threads) == -1) {
+        return 1;
+    }
+    if (inputFile != NULL || outputFile != NULL) {  // the batch holds many generated matrices
+        printf("Error: --input and --output are not supported by this program!\n\n");
+        return 1;
+    }
+
+    // Variables declaration
+    double ts, te;                        // execution times
+    double check1, transpose1;            // matrices per second of the batched kernels
+    double check2, transpose2;            // matrices per second of the kernels called on every matrix
+    double** M;                           // input matrices
+    double** T;                           // transposed matrices
+    size_t* rows;                         // rows of the matrices
+    size_t* cols;                         // columns of the matrices
+    bool* symmetric;                      // symmetry checks
+    size_t count, symmetric_count;        // number of matrices and of symmetric ones
+
+    // Matrices allocation
+    count = initBatch(&M, &T, &rows, &cols, m, n);
+    symmetric = (bool*)malloc(count * sizeof(bool));
+    if (count == 0 || symmetric == NULL) {
+        printf("Error in allocating matrices!\n\n");
+        return -1;
+    }
+
+    printf("Batch: %zu matrices with dimensions from %zu x %zu to %zu x %zu\n", count, m / 2 > 0 ? m / 2 : 1, n / 2 > 0 ? n / 2 : 1, m, n);
+    printf("Repetitions: %d\n\n", rep);
+
+    printf("Results: threads (T), symmetric matrices (S), matrices per second of batched symmetry (BS) and transpose (BT), ");
+    printf("of symmetry (PS) and transpose (PT) with a parallel region per matrix\n\n");
+    printf("\t|\tT\t|\tS\t|\tBS\t|\tBT\t|\tPS\t|\tPT\t|\n");
+
+    // Executions
+    for (int i = nextThreads(0, threads, true); i != 0; i = nextThreads(i, threads, true)) {  // the sequential and the passed threads
+        omp_set_num_threads(i);
+
+        ts = omp_get_wtime();
+        for (int j = 0; j < rep; j++) checkSymBatched((const double* const*)M, rows, cols, count, symmetric);
+        te = omp_get_wtime();
+        check1 = count * rep / (te - ts);
+
+        ts = omp_get_wtime();
+        for (int j = 0; j < rep; j++) matTransposeBatched((const double* const*)M, T, rows, cols, count);
+        te = omp_get_wtime();
+        transpose1 = count * rep / (te - ts);
+
+        symmetric_count = 0;
+        for (size_t k = 0; k < count; k++) symmetric_count += symmetric[k];
+
+        ts = omp_get_wtime();
+        for (int j = 0; j < rep; j++) {
+            for (size_t k = 0; k < count; k++) symmetric[k] = checkSymOMP(M[k], rows[k], cols[k]);
+        }
+        te = omp_get_wtime();
+        check2 = count * rep / (te - ts);
+
+        ts = omp_get_wtime();
+        for (int j = 0; j < rep; j++) {
+            for (size_t k = 0; k < count; k++) matTransposeOMP(M[k], T[k], rows[k], cols[k]);
+        }
+        te = omp_get_wtime();
+        transpose2 = count * rep / (te - ts);
+
+        // Results printing and saving
+        printf("\t| %d\t\t| %zu\t\t| %10.4g\t| %10.4g\t| %10.4g\t| %10.4g\t|\n", i, symmetric_count, check1, transpose1, check2, transpose2);
+
+        if (saveResultsBatched(CODE, m, n, i, count, check1, transpose1, check2, transpose2) == -1) {
+            printf("Error in saving results!\n\n");
+        }
+    }
+    // --------------------------------
+
+    bool transposed = true;
+    for (size_t k = 0; k < count; k++) transposed = transposed && isTransposeOf(M[k], T[k], rows[k], cols[k], 0);
+    printf("\nTested results: transposed %s.\n\n", transposed ? "correct" : "incorrect");
+
+    // Matrices deallocation
+    free(M[0]);
+    free(T[0]);
+    free(M);
+    free(T);
+    free(rows);
+    free(cols);
+    free(symmetric);
+
+    return 0;
+}
\ No newline at end of file
@@ -7,13 +7,24 @@
 #include <time.h>
 
 #include "functions.h"
-
+#include "simd.h"
+
+#if defined(STREAM)
+#define CODE "OBVS"
+#elif defined(SIMD)
+#define CODE "OBV"
+#elif defined(HUGE_PAGES)
+#define CODE "OBH"
+#else
 #define CODE "OB"
+#endif
 
 #define BLOCK_SIZE 32
 
-bool checkSymOMP(const double* M, int n) {
-    const int size = BLOCK_SIZE < n ? BLOCK_SIZE : n / omp_get_num_threads();
+bool checkSymOMP(const double* M, size_t m, size_t n) {
+    if (m != n) return false;  // only square matrices can be symmetric
+    const size_t size = BLOCK_SIZE < n ? BLOCK_SIZE : n / omp_get_num_threads();
+    const size_t blocks = blockCount(n, size);
     bool check = true;
 
 #pragma omp parallel reduction(&& : check)
@@ -25,17 +36,11 @@ bool checkSymOMP(const double* M, int n) {
 #pragma omp allocate(first, last, c) allocator(omp_thread_mem_alloc)
 
 #pragma omp for
-        for (int rb = 0; rb < n / size; rb++) {    // row blocks indexing
-            for (int cb = 0; cb <= rb; cb++) {     // column blocks indexing
+        for (size_t rb = 0; rb < blocks; rb++) {   // row blocks indexing
+            for (size_t cb = 0; cb <= rb; cb++) {  // column blocks indexing
                 first = M + (rb * n + cb) * size;  // block matrix of lower triangular part
                 last = M + (cb * n + rb) * size;   // block matrix of higher triangular part
-                for (int i = 0; i < size; i++) {   // symmetry check
-                    for (int j = 0; j < size; j++) {
-                        if (fabs(first[i * n + j] - last[j * n + i]) > EPSILON) {
-                            c = false;
-                        }
-                    }
-                }
+                c &= checkBlock(first, last, n, blockLength(n, rb, size), blockLength(n, cb, size), rb == cb);  // tile-pair comparison in registers
             }
         }
 
@@ -45,8 +50,15 @@ bool checkSymOMP(const double* M, int n) {
     return check;
 }
 
-void matTransposeOMP(const double* M, double* T, int n) {
-    const int size = BLOCK_SIZE < n ? BLOCK_SIZE : n / omp_get_num_threads();
+void matTransposeOMP(const double* M, double* T, size_t m, size_t n) {
+    const size_t size = BLOCK_SIZE < n ? BLOCK_SIZE : n / omp_get_num_threads();
+    const size_t row_blocks = blockCount(m, size);
+    const size_t col_blocks = blockCount(n, size);
+#if defined(STREAM)
+    const bool stream = useStreaming(T, m, n, size);  // streaming stores only above STREAM_THRESHOLD
+#else
+    const bool stream = false;
+#endif
 #pragma omp parallel
     {
         const double* source;
@@ -54,17 +66,19 @@ void matTransposeOMP(const double* M, double* T, int n) {
 #pragma omp allocate(source, destination) allocator(omp_thread_mem_alloc)
 
 #pragma omp for collapse(2)
-        for (int rb = 0; rb < n / size; rb++) {          // row blocks indexing
-            for (int cb = 0; cb < n / size; cb++) {      // column blocks indexing
+        for (size_t rb = 0; rb < row_blocks; rb++) {     // row blocks indexing
+            for (size_t cb = 0; cb < col_blocks; cb++) { // column blocks indexing
                 source = M + (rb * n + cb) * size;       // block matrix of lower triangular part
-                destination = T + (cb * n + rb) * size;  // block matrix of higher triangular part
-                for (int i = 0; i < size; i++) {         // transposing
-                    for (int j = 0; j < size; j++) {
-                        destination[j * n + i] = source[i * n + j];
-                    }
+                destination = T + (cb * m + rb) * size;  // block matrix of higher triangular part
+                if (stream) {
+                    transposeBlockStream(source, n, destination, m, blockLength(m, rb, size), blockLength(n, cb, size));
+                } else {
+                    transposeBlock(source, n, destination, m, blockLength(m, rb, size), blockLength(n, cb, size));  // transposing with register tiles
                 }
             }
         }
+
+        if (stream) _mm_sfence();  // the streaming stores of every thread are completed before leaving the region
     }
 }
 
@@ -76,28 +90,15 @@ int __attribute__((optimize("O0"))) main(int argc, char** argv) {
     printf("Error: compile with -fopenmp flag");
 #endif
 
-    int dim = 0;
+    size_t m = 0;
+    size_t n = 0;
     int rep = 0;
     int threads = 0;
-    if (argc < 2) {
-        printf("Correct usage: program-name [M dimension as exponent of 2] [number of repetitions (default 5)] [number of threads (0 to run all cases)]\n\n");
+    if (parseArguments(argc, argv, &m, &n, &rep, &threads) == -1) {
         return 1;
-    } else if (argc == 2) {
-        dim = atoi(argv[1]);
-        rep = 500;
-        threads = 0;
-    } else if (argc == 3) {
-        dim = atoi(argv[1]);
-        rep = atoi(argv[2]) > 0 ? atoi(argv[2]) : 500;
-        threads = 0;
-    } else {
-        dim = atoi(argv[1]);
-        rep = atoi(argv[2]) > 0 ? atoi(argv[2]) : 500;
-        threads = atoi(argv[3]) >= 0 ? atoi(argv[3]) : 0;
     }
 
-    unsigned int n = pow(2, dim);
-    printf("Matrix dimension: %d\n", n);
+    printf("Matrix dimensions: %zu x %zu\n", m, n);
     printf("Repetitions: %d\n\n", rep);
 
     // Variables declaration
@@ -105,22 +106,33 @@ int __attribute__((optimize("O0"))) main(int argc, char** argv) {
     bool symmetric = false;                     // symmetry check
     double* M;                                  // input matrix
     double* T;                                  // transposed matrix
+    struct TLBCounter counter;                  // dTLB misses counter, opened before the threads are created
+    long long misses1, misses2;                 // dTLB misses of the two routines
 
     // Matrices allocation
-    if (initMatrices(&M, &T, n) == -1) {
+    if (initMatrices(&M, &T, m, n) == -1) {
         printf("Error in allocating matrices!\n\n");
         return -1;
     }
 
+#if defined(STREAM)
+    printf("Transpose stores: %s\n\n", useStreaming(T, m, n, BLOCK_SIZE < n ? BLOCK_SIZE : n) ? "streaming" : "regular");
+#endif
+
+    openTLBCounter(&counter);
     omp_set_num_threads(1);
 
+    startTLBCounter(&counter);
     ts1 = omp_get_wtime();
-    for (int i = 0; i < rep; i++) symmetric = checkSymOMP(M, n);
+    for (int i = 0; i < rep; i++) symmetric = checkSymOMP(M, m, n);
     te1 = omp_get_wtime();
+    misses1 = stopTLBCounter(&counter, rep);
 
+    startTLBCounter(&counter);
     ts2 = omp_get_wtime();
-    for (int i = 0; i < rep; i++) matTransposeOMP(M, T, n);
+    for (int i = 0; i < rep; i++) matTransposeOMP(M, T, m, n);
     te2 = omp_get_wtime();
+    misses2 = stopTLBCounter(&counter, rep);
 
     s1 = (te1 - ts1) / rep;
     s2 = (te2 - ts2) / rep;
@@ -130,26 +142,35 @@ int __attribute__((optimize("O0"))) main(int argc, char** argv) {
     printf("matTransposeOMP:%.9f seconds\n\n", s2);
 
     printf("Results: threads (T), symmetry (S), ");
-    printf("symmetry speedup (SS), symmetry efficiency (SE), transpose speedup (TS), transpose efficiency (TE), transpose bandwidth in GB/s (TB) \n\n");
-    printf("\t|\tT\t|\tS\t|\tSS\t|\tSE\t|\tTS\t|\tTE\t|\tTB\t|\n");
+    printf("symmetry speedup (SS), symmetry efficiency (SE), transpose speedup (TS), transpose efficiency (TE), transpose bandwidth in GB/s (TB), ");
+    printf("dTLB misses per repetition of symmetry (SM) and transpose (TM), -1 if not available\n\n");
+    printf("\t|\tT\t|\tS\t|\tSS\t|\tSE\t|\tTS\t|\tTE\t|\tTB\t|\tSM\t|\tTM\t|\n");
 
-    double bandwidth = 2 * n * n * sizeof(double) / (s2);
-    if (saveResultsOMP(CODE, n, 1, 1, 100, 1, 100, bandwidth) == -1) {
+    double bandwidth = 2 * m * n * sizeof(double) / (s2);
+    if (saveResultsOMP(CODE, m, n, 1, 1, 100, 1, 100, bandwidth) == -1) {
+        printf("Error in saving results!\n\n");
+    }
+    if (misses1 != -1 && misses2 != -1 && saveResultsTLB(CODE, m, n, 1, misses1, misses2) == -1) {
         printf("Error in saving results!\n\n");
     }
+    printf("\t| 1\t\t| %d\t\t| %8.4f\t| %8.4f\t| %8.4f\t| %8.4f\t| %8.4f\t| %lld\t| %lld\t|\n", symmetric, 1.0, 100.0, 1.0, 100.0, bandwidth * 1e-9, misses1, misses2);
 
     // Executions
     if (threads == 0) {
         for (int i = 2; i <= 64; i *= 2) {
             omp_set_num_threads(i);
 
+            startTLBCounter(&counter);
             ts1 = omp_get_wtime();
-            for (int j = 0; j < rep; j++) symmetric = checkSymOMP(M, n);
+            for (int j = 0; j < rep; j++) symmetric = checkSymOMP(M, m, n);
             te1 = omp_get_wtime();
+            misses1 = stopTLBCounter(&counter, rep);
 
+            startTLBCounter(&counter);
             ts2 = omp_get_wtime();
-            for (int j = 0; j < rep; j++) matTransposeOMP(M, T, n);
+            for (int j = 0; j < rep; j++) matTransposeOMP(M, T, m, n);
             te2 = omp_get_wtime();
+            misses2 = stopTLBCounter(&counter, rep);
 
             // Results printing and saving
             t1 = (te1 - ts1) / rep;
@@ -159,23 +180,30 @@ int __attribute__((optimize("O0"))) main(int argc, char** argv) {
             double efficiency1 = (double)speedup1 / i * 100;
             double speedup2 = (double)s2 / t2;
             double efficiency2 = (double)speedup2 / i * 100;
-            double bandwidth = 2 * n * n * sizeof(double) / (t2);
+            double bandwidth = 2 * m * n * sizeof(double) / (t2);
 
-            printf("\t| %d\t\t| %d\t\t| %8.4f\t| %8.4f\t| %8.4f\t| %8.4f\t| %8.4f\t|\n", i, symmetric, speedup1, efficiency1, speedup2, efficiency2, bandwidth * 1e-9);
+            printf("\t| %d\t\t| %d\t\t| %8.4f\t| %8.4f\t| %8.4f\t| %8.4f\t| %8.4f\t| %lld\t| %lld\t|\n", i, symmetric, speedup1, efficiency1, speedup2, efficiency2, bandwidth * 1e-9, misses1, misses2);
 
-            if (saveResultsOMP(CODE, n, i, speedup1, efficiency1, speedup2, efficiency2, bandwidth) == -1) {
+            if (saveResultsOMP(CODE, m, n, i, speedup1, efficiency1, speedup2, efficiency2, bandwidth) == -1) {
+                printf("Error in saving results!\n\n");
+            }
+            if (misses1 != -1 && misses2 != -1 && saveResultsTLB(CODE, m, n, i, misses1, misses2) == -1) {
                 printf("Error in saving results!\n\n");
             }
         }
     } else {
         omp_set_num_threads(threads);
+        startTLBCounter(&counter);
         ts1 = omp_get_wtime();
-        for (int j = 0; j < rep; j++) symmetric = checkSymOMP(M, n);
+        for (int j = 0; j < rep; j++) symmetric = checkSymOMP(M, m, n);
         te1 = omp_get_wtime();
+        misses1 = stopTLBCounter(&counter, rep);
 
+        startTLBCounter(&counter);
         ts2 = omp_get_wtime();
-        for (int j = 0; j < rep; j++) matTransposeOMP(M, T, n);
+        for (int j = 0; j < rep; j++) matTransposeOMP(M, T, m, n);
         te2 = omp_get_wtime();
+        misses2 = stopTLBCounter(&counter, rep);
 
         // Results printing and saving
         t1 = (te1 - ts1) / rep;
@@ -185,22 +213,26 @@ int __attribute__((optimize("O0"))) main(int argc, char** argv) {
         double efficiency1 = (double)speedup1 / threads * 100;
         double speedup2 = (double)s2 / t2;
         double efficiency2 = (double)speedup2 / threads * 100;
-        double bandwidth = 2 * n * n * sizeof(double) / (t2);
+        double bandwidth = 2 * m * n * sizeof(double) / (t2);
 
-        printf("\t| %d\t\t| %d\t\t| %8.4f\t| %8.4f\t| %8.4f\t| %8.4f\t| %8.4f\t|\n", threads, symmetric, speedup1, efficiency1, speedup2, efficiency2, bandwidth);
+        printf("\t| %d\t\t| %d\t\t| %8.4f\t| %8.4f\t| %8.4f\t| %8.4f\t| %8.4f\t| %lld\t| %lld\t|\n", threads, symmetric, speedup1, efficiency1, speedup2, efficiency2, bandwidth * 1e-9, misses1, misses2);
 
-        if (saveResultsOMP(CODE, n, threads, speedup1, efficiency1, speedup2, efficiency2, bandwidth) == -1) {
+        if (saveResultsOMP(CODE, m, n, threads, speedup1, efficiency1, speedup2, efficiency2, bandwidth) == -1) {
+            printf("Error in saving results!\n\n");
+        }
+        if (misses1 != -1 && misses2 != -1 && saveResultsTLB(CODE, m, n, threads, misses1, misses2) == -1) {
             printf("Error in saving results!\n\n");
         }
     }
     // --------------------------------
 
     printf("\n");
-    testResults(M, T, n);
+    testResults(M, T, m, n);
 
-    // Matrices deallocation
+    // Matrices and counter deallocation
     free(M);
     free(T);
+    closeTLBCounter(&counter);
 
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,247 @@
+#include <immintrin.h>
+#include <math.h>
+#include <omp.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "functions.h"
+
+#define CODE "OCO"
+
+// Side of the sub-matrices below which the recursion stops, can be tuned with -DCUTOFF=...
+#ifndef CUTOFF
+#define CUTOFF 16
+#endif
+
+// Side of the sub-matrices below which no more tasks are created, can be tuned with -DTASK_CUTOFF=...
+#ifndef TASK_CUTOFF
+#define TASK_CUTOFF 128
+#endif
+
+// Checks M[i][j] == M[j][i] for rows [r0, r1) and columns [c0, c1), splitting the longer dimension.
+// The halves are checked by different tasks, which clear the shared check flag on mismatch
+void checkSymRect(const double* M, size_t n, size_t r0, size_t r1, size_t c0, size_t c1, bool* check) {
+    if (r1 - r0 <= CUTOFF && c1 - c0 <= CUTOFF) {
+        bool c = true;
+        for (size_t i = r0; i < r1; i++) {
+            for (size_t j = c0; j < c1; j++) {
+                if (fabs(M[i * n + j] - M[j * n + i]) > EPSILON) {
+                    c = false;
+                }
+            }
+        }
+        if (!c) {
+#pragma omp atomic write
+            *check = false;
+        }
+        return;
+    }
+
+    if (r1 - r0 >= c1 - c0) {
+        size_t mid = r0 + (r1 - r0) / 2;
+#pragma omp task if (r1 - r0 > TASK_CUTOFF)
+        checkSymRect(M, n, r0, mid, c0, c1, check);
+        checkSymRect(M, n, mid, r1, c0, c1, check);
+    } else {
+        size_t mid = c0 + (c1 - c0) / 2;
+#pragma omp task if (c1 - c0 > TASK_CUTOFF)
+        checkSymRect(M, n, r0, r1, c0, mid, check);
+        checkSymRect(M, n, r0, r1, mid, c1, check);
+    }
+}
+
+// Checks the lower triangular part of the diagonal sub-matrix [d0, d1) x [d0, d1), which is split
+// into two smaller triangles and the rectangle below the first one
+void checkSymTriangle(const double* M, size_t n, size_t d0, size_t d1, bool* check) {
+    if (d1 - d0 <= CUTOFF) {
+        bool c = true;
+        for (size_t i = d0 + 1; i < d1; i++) {
+            for (size_t j = d0; j < i; j++) {
+                if (fabs(M[i * n + j] - M[j * n + i]) > EPSILON) {
+                    c = false;
+                }
+            }
+        }
+        if (!c) {
+#pragma omp atomic write
+            *check = false;
+        }
+        return;
+    }
+
+    size_t mid = d0 + (d1 - d0) / 2;
+#pragma omp task if (d1 - d0 > TASK_CUTOFF)
+    checkSymTriangle(M, n, d0, mid, check);
+#pragma omp task if (d1 - d0 > TASK_CUTOFF)
+    checkSymTriangle(M, n, mid, d1, check);
+    checkSymRect(M, n, mid, d1, d0, mid, check);
+}
+
+bool checkSymOMP(const double* M, size_t m, size_t n) {
+    if (m != n) return false;  // only square matrices can be symmetric
+    bool check = true;
+
+    // the tasks are all completed at the implicit barrier at the end of the parallel region
+#pragma omp parallel
+#pragma omp single
+    checkSymTriangle(M, n, 0, n, &check);
+
+    return check;
+}
+
+// Transposes rows [r0, r1) and columns [c0, c1) of M (m x n) into T (n x m), splitting the longer dimension.
+// The halves are transposed by different tasks
+void matTransposeRect(const double* M, double* T, size_t m, size_t n, size_t r0, size_t r1, size_t c0, size_t c1) {
+    if (r1 - r0 <= CUTOFF && c1 - c0 <= CUTOFF) {
+        for (size_t i = r0; i < r1; i++) {
+            for (size_t j = c0; j < c1; j++) {
+                T[j * m + i] = M[i * n + j];
+            }
+        }
+        return;
+    }
+
+    if (r1 - r0 >= c1 - c0) {
+        size_t mid = r0 + (r1 - r0) / 2;
+#pragma omp task if (r1 - r0 > TASK_CUTOFF)
+        matTransposeRect(M, T, m, n, r0, mid, c0, c1);
+        matTransposeRect(M, T, m, n, mid, r1, c0, c1);
+    } else {
+        size_t mid = c0 + (c1 - c0) / 2;
+#pragma omp task if (c1 - c0 > TASK_CUTOFF)
+        matTransposeRect(M, T, m, n, r0, r1, c0, mid);
+        matTransposeRect(M, T, m, n, r0, r1, mid, c1);
+    }
+}
+
+void matTransposeOMP(const double* M, double* T, size_t m, size_t n) {
+#pragma omp parallel
+#pragma omp single
+    matTransposeRect(M, T, m, n, 0, m, 0, n);
+}
+
+// The attribute is necessary to avoid the compiler optimization on the repetitions loops
+int __attribute__((optimize("O0"))) main(int argc, char** argv) {
+#ifdef _OPENMP
+    printf("Compiled with OpenMP %d.%02d\n", _OPENMP / 100, _OPENMP % 100);
+#else
+    printf("Error: compile with -fopenmp flag");
+#endif
+
+    size_t m = 0;
+    size_t n = 0;
+    int rep = 0;
+    int threads = 0;
+    if (parseArguments(argc, argv, &m, &n, &rep, &threads) == -1) {
+        return 1;
+    }
+
+    printf("Matrix dimensions: %zu x %zu\n", m, n);
+    printf("Repetitions: %d\n\n", rep);
+
+    // Variables declaration
+    double ts1, ts2, te1, te2, t1, t2, s1, s2;  // execution times
+    bool symmetric = false;                     // symmetry check
+    double* M;                                  // input matrix
+    double* T;                                  // transposed matrix
+
+    // Matrices allocation
+    if (initMatrices(&M, &T, m, n) == -1) {
+        printf("Error in allocating matrices!\n\n");
+        return -1;
+    }
+
+    omp_set_num_threads(1);
+
+    ts1 = omp_get_wtime();
+    for (int i = 0; i < rep; i++) symmetric = checkSymOMP(M, m, n);
+    te1 = omp_get_wtime();
+
+    ts2 = omp_get_wtime();
+    for (int i = 0; i < rep; i++) matTransposeOMP(M, T, m, n);
+    te2 = omp_get_wtime();
+
+    s1 = (te1 - ts1) / rep;
+    s2 = (te2 - ts2) / rep;
+
+    printf("Sequential execution: symmetry: %s\n", symmetric ? "true" : "false");
+    printf("checkSymOMP:\t%.9f seconds\n", s1);
+    printf("matTransposeOMP:%.9f seconds\n\n", s2);
+
+    printf("Results: threads (T), symmetry (S), ");
+    printf("symmetry speedup (SS), symmetry efficiency (SE), transpose speedup (TS), transpose efficiency (TE), transpose bandwidth in GB/s (TB) \n\n");
+    printf("\t|\tT\t|\tS\t|\tSS\t|\tSE\t|\tTS\t|\tTE\t|\tTB\t|\n");
+    
+    double bandwidth = 2 * m * n * sizeof(double) / (s2);
+    if (saveResultsOMP(CODE, m, n, 1, 1, 100, 1, 100, bandwidth) == -1) {
+        printf("Error in saving results!\n\n");
+    }
+
+    // Executions
+    if (threads == 0) {
+        for (int i = 2; i <= 64; i *= 2) {
+            omp_set_num_threads(i);
+
+            ts1 = omp_get_wtime();
+            for (int j = 0; j < rep; j++) symmetric = checkSymOMP(M, m, n);
+            te1 = omp_get_wtime();
+
+            ts2 = omp_get_wtime();
+            for (int j = 0; j < rep; j++) matTransposeOMP(M, T, m, n);
+            te2 = omp_get_wtime();
+
+            // Results printing and saving
+            t1 = (te1 - ts1) / rep;
+            t2 = (te2 - ts2) / rep;
+
+            double speedup1 = (double)s1 / t1;
+            double efficiency1 = (double)speedup1 / i * 100;
+            double speedup2 = (double)s2 / t2;
+            double efficiency2 = (double)speedup2 / i * 100;
+            double bandwidth = 2 * m * n * sizeof(double) / (t2);
+
+            printf("\t| %d\t\t| %d\t\t| %8.4f\t| %8.4f\t| %8.4f\t| %8.4f\t| %8.4f\t|\n", i, symmetric, speedup1, efficiency1, speedup2, efficiency2, bandwidth * 1e-9);
+
+            if (saveResultsOMP(CODE, m, n, i, speedup1, efficiency1, speedup2, efficiency2, bandwidth) == -1) {
+                printf("Error in saving results!\n\n");
+            }
+        }
+    } else {
+        omp_set_num_threads(threads);
+        ts1 = omp_get_wtime();
+        for (int j = 0; j < rep; j++) symmetric = checkSymOMP(M, m, n);
+        te1 = omp_get_wtime();
+
+        ts2 = omp_get_wtime();
+        for (int j = 0; j < rep; j++) matTransposeOMP(M, T, m, n);
+        te2 = omp_get_wtime();
+
+        // Results printing and saving
+        t1 = (te1 - ts1) / rep;
+        t2 = (te2 - ts2) / rep;
+
+        double speedup1 = (double)s1 / t1;
+        double efficiency1 = (double)speedup1 / threads * 100;
+        double speedup2 = (double)s2 / t2;
+        double efficiency2 = (double)speedup2 / threads * 100;
+        double bandwidth = 2 * m * n * sizeof(double) / (t2);
+
+        printf("\t| %d\t\t| %d\t\t| %8.4f\t| %8.4f\t| %8.4f\t| %8.4f\t| %8.4f\t|\n", threads, symmetric, speedup1, efficiency1, speedup2, efficiency2, bandwidth * 1e-9);
+
+        if (saveResultsOMP(CODE, m, n, threads, speedup1, efficiency1, speedup2, efficiency2, bandwidth) == -1) {
+            printf("Error in saving results!\n\n");
+        }
+    }
+    // --------------------------------
+
+    printf("\n");
+    testResults(M, T, m, n);
+
+    // Matrices deallocation
+    free(M);
+    free(T);
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,146 @@
+#include <immintrin.h>
+#include <math.h>
+#include <omp.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "functions.h"
+#include "simd.h"
+
+#define CODE "OE"
+
+#define BLOCK_SIZE 32
+
+bool checkSymOMP(const double* M, size_t m, size_t n) {
+    if (m != n) return false;  // only square matrices can be symmetric
+    const size_t size = BLOCK_SIZE < n ? BLOCK_SIZE : n / omp_get_num_threads();
+    const size_t blocks = blockCount(n, size);
+    bool check = true;
+
+#pragma omp parallel for schedule(dynamic, 1) reduction(&& : check)
+    for (size_t rb = 0; rb < blocks; rb++) {                 // row blocks indexing
+        for (size_t cb = 0; cb <= rb; cb++) {                // column blocks indexing
+            const double* first = M + (rb * n + cb) * size;  // block matrix of lower triangular part
+            const double* last = M + (cb * n + rb) * size;   // block matrix of higher triangular part
+            check &= checkBlock(first, last, n, blockLength(n, rb, size), blockLength(n, cb, size), rb == cb);
+        }
+    }
+
+    return check;
+}
+
+// Same traversal of checkSymOMP, the threads share a flag that is raised by the first thread finding a pair
+// of blocks that is not symmetric and polled before every pair of blocks, so that all the threads stop within
+// one pair of blocks. The atomic accesses have relaxed ordering since the flag does not publish other data.
+// The time of the first rejection is saved in detected.
+bool checkSymEarlyExitOMP(const double* M, size_t m, size_t n, double* detected) {
+    if (m != n) {  // only square matrices can be symmetric
+        *detected = omp_get_wtime();
+        return false;
+    }
+    const size_t size = BLOCK_SIZE < n ? BLOCK_SIZE : n / omp_get_num_threads();
+    const size_t blocks = blockCount(n, size);
+    int rejected = 0;
+
+#pragma omp parallel for schedule(dynamic, 1)
+    for (size_t rb = 0; rb < blocks; rb++) {                 // row blocks indexing
+        for (size_t cb = 0; cb <= rb; cb++) {                // column blocks indexing
+            int stop;
+#pragma omp atomic read
+            stop = rejected;
+            if (stop) break;
+
+            const double* first = M + (rb * n + cb) * size;  // block matrix of lower triangular part
+            const double* last = M + (cb * n + rb) * size;   // block matrix of higher triangular part
+            if (!checkBlock(first, last, n, blockLength(n, rb, size), blockLength(n, cb, size), rb == cb)) {
+                int previous;
+#pragma omp atomic capture
+                {
+                    previous = rejected;
+                    rejected = 1;
+                }
+                if (!previous) *detected = omp_get_wtime();  // only the first rejection is timed
+                break;
+            }
+        }
+    }
+
+    return !rejected;
+}
+
+// The attribute is necessary to avoid the compiler optimization on the repetitions loops
+int __attribute__((optimize("O0"))) main(int argc, char** argv) {
+#ifdef _OPENMP
+    printf("Compiled with OpenMP %d.%02d\n", _OPENMP / 100, _OPENMP % 100);
+#else
+    printf("Error: compile with -fopenmp flag");
+#endif
+
+    size_t m = 0;
+    size_t n = 0;
+    int rep = 0;
+    int threads = 0;
+    if (parseArguments(argc, argv, &m, &n, &rep, &threads) == -1) {
+        return 1;
+    }
+
+    printf("Matrix dimensions: %zu x %zu\n", m, n);
+    printf("Repetitions: %d\n\n", rep);
+
+    // Variables declaration
+    double ts1, ts2, te1, te2, detected;  // execution times
+    bool symmetric = false;               // symmetry check
+    bool early = false;                   // symmetry check with early exit
+    bool correct = true;                  // agreement of the two checks
+    double* M;                            // input matrix
+
+    // Matrix allocation
+    if (initMatrix(&M, m, n) == -1) {
+        printf("Error in allocating matrices!\n\n");
+        return -1;
+    }
+
+    printf("Results: threads (T), symmetry (S), ");
+    printf("full scan time (F), time to the first rejection (R), early exit time (E) in seconds\n\n");
+    printf("\t|\tT\t|\tS\t|\tF\t|\tR\t|\tE\t|\n");
+
+    // Executions
+    for (int i = nextThreads(0, threads, true); i != 0; i = nextThreads(i, threads, true)) {  // the sequential and the passed threads
+        omp_set_num_threads(i);
+
+        ts1 = omp_get_wtime();
+        for (int j = 0; j < rep; j++) symmetric = checkSymOMP(M, m, n);
+        te1 = omp_get_wtime();
+
+        double full = (te1 - ts1) / rep;
+        double rejection = 0;
+        double termination = 0;
+        for (int j = 0; j < rep; j++) {
+            ts2 = omp_get_wtime();
+            early = checkSymEarlyExitOMP(M, m, n, &detected);
+            te2 = omp_get_wtime();
+
+            termination += te2 - ts2;
+            rejection += early ? te2 - ts2 : detected - ts2;  // symmetric inputs are never rejected
+        }
+        rejection = rejection / rep;
+        termination = termination / rep;
+        correct = correct && symmetric == early;
+
+        printf("\t| %d\t\t| %d\t\t| %.9f\t| %.9f\t| %.9f\t|\n", i, early, full, rejection, termination);
+
+        if (saveResultsEarlyExit(CODE, m, n, i, full, rejection, termination) == -1) {
+            printf("Error in saving results!\n\n");
+        }
+    }
+    // --------------------------------
+
+    printf("\nTested results: early exit %s.\n\n", correct ? "correct" : "incorrect");
+
+    // Matrix deallocation
+    free(M);
+
+    return 0;
+}
\ No newline at end of file
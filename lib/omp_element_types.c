@@ -0,0 +1,114 @@
+#include <float.h>
+#include <immintrin.h>
+#include <math.h>
+#include <omp.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "functions.h"
+#include "types.h"
+
+// The codes of the results are OB_ followed by the element type (OB_F16, OB_BF16, OB_F32, OB_F64, OB_I32, OB_I64, OB_C128)
+
+// Defines benchmark_name, which times the blocked OpenMP kernels check and transpose on matrices of type for every
+// number of threads and saves the results with code. The bandwidth is computed with the size of the element type.
+// The attribute is necessary to avoid the compiler optimization on the repetitions loops
+#define BENCHMARK(name, type, code, check, transpose)                                                                      \
+    int __attribute__((optimize("O0"))) benchmark_##name(size_t m, size_t n, int rep, int threads) {                      \
+        double ts1, ts2, te1, te2, t1, t2, s1 = 0, s2 = 0; /* execution times */                                         \
+        bool symmetric = false;                            /* symmetry check */                                          \
+        type* M;                                           /* input matrix */                                            \
+        type* T;                                           /* transposed matrix */                                       \
+                                                                                                                          \
+        if (initMatrices_##name(&M, &T, m, n) == -1) {                                                                    \
+            printf("Error in allocating matrices!\n\n");                                                                  \
+            return -1;                                                                                                    \
+        }                                                                                                                 \
+                                                                                                                          \
+        printf("%s (%s, %zu bytes)\n", code, #type, sizeof(type));                                                       \
+        printf("\t|\tT\t|\tS\t|\tSS\t|\tSE\t|\tTS\t|\tTE\t|\tTB\t|\n");                                                  \
+                                                                                                                          \
+        for (int i = nextThreads(0, threads, true); i != 0; i = nextThreads(i, threads, true)) {                          \
+            omp_set_num_threads(i);                                                                                       \
+                                                                                                                          \
+            ts1 = omp_get_wtime();                                                                                        \
+            for (int j = 0; j < rep; j++) symmetric = check(M, m, n);                                                     \
+            te1 = omp_get_wtime();                                                                                        \
+                                                                                                                          \
+            ts2 = omp_get_wtime();                                                                                        \
+            for (int j = 0; j < rep; j++) transpose(M, T, m, n);                                                          \
+            te2 = omp_get_wtime();                                                                                        \
+                                                                                                                          \
+            /* Results printing and saving */                                                                             \
+            t1 = (te1 - ts1) / rep;                                                                                       \
+            t2 = (te2 - ts2) / rep;                                                                                       \
+            if (i == 1) {                                                                                                 \
+                s1 = t1;                                                                                                  \
+                s2 = t2;                                                                                                  \
+            }                                                                                                             \
+                                                                                                                          \
+            double speedup1 = (double)s1 / t1;                                                                            \
+            double efficiency1 = (double)speedup1 / i * 100;                                                              \
+            double speedup2 = (double)s2 / t2;                                                                            \
+            double efficiency2 = (double)speedup2 / i * 100;                                                              \
+            double bandwidth = 2 * m * n * sizeof(type) / (t2);                                                           \
+                                                                                                                          \
+            printf("\t| %d\t\t| %d\t\t| %8.4f\t| %8.4f\t| %8.4f\t| %8.4f\t| %8.4f\t|\n", i, symmetric, speedup1, efficiency1, \
+                   speedup2, efficiency2, bandwidth * 1e-9);                                                              \
+                                                                                                                          \
+            if (saveResultsOMP(code, m, n, i, speedup1, efficiency1, speedup2, efficiency2, bandwidth) == -1) {           \
+                printf("Error in saving results!\n\n");                                                                   \
+            }                                                                                                             \
+        }                                                                                                                 \
+                                                                                                                          \
+        printf("Tested results: transposed %s.\n\n", isTransposed_##name(M, T, m, n) ? "correct" : "incorrect");         \
+                                                                                                                          \
+        free(M);                                                                                                          \
+        free(T);                                                                                                          \
+        return 0;                                                                                                         \
+    }
+
+BENCHMARK(f16, half, "OB_F16", checkSymGenericOMP, matTransposeGenericOMP)
+BENCHMARK(bf16, bfloat16, "OB_BF16", checkSymGenericOMP, matTransposeGenericOMP)
+BENCHMARK(f32, float, "OB_F32", checkSymGenericOMP, matTransposeGenericOMP)
+BENCHMARK(f64, double, "OB_F64", checkSymGenericOMP, matTransposeGenericOMP)
+BENCHMARK(i32, int32_t, "OB_I32", checkSymGenericOMP, matTransposeGenericOMP)
+BENCHMARK(i64, int64_t, "OB_I64", checkSymGenericOMP, matTransposeGenericOMP)
+BENCHMARK(c128h, complex double, "OB_C128", checkHermitianOMP, matConjTransposeOMP)  // Hermitian check and conjugate transpose
+
+int main(int argc, char** argv) {
+#ifdef _OPENMP
+    printf("Compiled with OpenMP %d.%02d\n", _OPENMP / 100, _OPENMP % 100);
+#else
+    printf("Error: compile with -fopenmp flag");
+#endif
+
+    size_t m = 0;
+    size_t n = 0;
+    int rep = 0;
+    int threads = 0;
+    if (parseArguments(argc, argv, &m, &n, &rep, &threads) == -1) {
+        return 1;
+    }
+    if (inputFile != NULL || outputFile != NULL) {  // only row-major double matrices are loaded and saved
+        printf("Error: --input and --output are not supported by this program!\n\n");
+        return 1;
+    }
+
+    printf("Matrix dimensions: %zu x %zu\n", m, n);
+    printf("Repetitions: %d\n\n", rep);
+
+    printf("Results: threads (T), symmetry (S), ");
+    printf("symmetry speedup (SS), symmetry efficiency (SE), transpose speedup (TS), transpose efficiency (TE), transpose bandwidth in GB/s (TB)\n\n");
+
+    // Executions, from the narrowest element type
+    if (benchmark_f16(m, n, rep, threads) == -1 || benchmark_bf16(m, n, rep, threads) == -1 || benchmark_f32(m, n, rep, threads) == -1 ||
+        benchmark_f64(m, n, rep, threads) == -1 || benchmark_i32(m, n, rep, threads) == -1 || benchmark_i64(m, n, rep, threads) == -1 ||
+        benchmark_c128h(m, n, rep, threads) == -1) {
+        return -1;
+    }
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,143 @@
+#include <immintrin.h>
+#include <math.h>
+#include <omp.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "functions.h"
+#include "freivalds.h"
+
+#if defined(SIMD)
+#define CODE "OFRV"
+#else
+#define CODE "OFR"
+#endif
+
+#define BLOCK_SIZE 32
+
+// Exact symmetry check of OB_D: the pairs of blocks of the lower triangular part are compared by rows in parallel
+bool checkSymOMP(const double* M, size_t m, size_t n) {
+    if (m != n) return false;  // only square matrices can be symmetric
+    const size_t size = BLOCK_SIZE < n ? BLOCK_SIZE : n;
+    const size_t blocks = blockCount(n, size);
+    bool check = true;
+
+#pragma omp parallel for schedule(dynamic, 1) reduction(&& : check)
+    for (size_t rb = 0; rb < blocks; rb++) {                 // row blocks indexing
+        for (size_t cb = 0; cb <= rb; cb++) {                // column blocks indexing
+            const double* first = M + (rb * n + cb) * size;  // block matrix of lower triangular part
+            const double* last = M + (cb * n + rb) * size;   // block matrix of higher triangular part
+            check &= checkBlock(first, last, n, blockLength(n, rb, size), blockLength(n, cb, size), rb == cb);
+        }
+    }
+
+    return check;
+}
+
+// Filtered symmetry check: the exact kernel only runs on the matrices that pass the streaming pre-filter
+bool checkSymFiltered(const double* M, size_t m, size_t n) {
+    return checkSymFreivalds(M, m, n) && checkSymOMP(M, m, n);
+}
+
+void matTransposeOMP(const double* M, double* T, size_t m, size_t n) {
+    const size_t size = BLOCK_SIZE < n ? BLOCK_SIZE : n;
+    const size_t row_blocks = blockCount(m, size);
+    const size_t col_blocks = blockCount(n, size);
+
+#pragma omp parallel for collapse(2)
+    for (size_t rb = 0; rb < row_blocks; rb++) {      // row blocks indexing
+        for (size_t cb = 0; cb < col_blocks; cb++) {  // column blocks indexing
+            transposeBlock(M + (rb * n + cb) * size, n, T + (cb * m + rb) * size, m, blockLength(m, rb, size), blockLength(n, cb, size));
+        }
+    }
+}
+
+// The attribute is necessary to avoid the compiler optimization on the repetitions loops
+int __attribute__((optimize("O0"))) main(int argc, char** argv) {
+#ifdef _OPENMP
+    printf("Compiled with OpenMP %d.%02d\n", _OPENMP / 100, _OPENMP % 100);
+#else
+    printf("Error: compile with -fopenmp flag");
+#endif
+
+    size_t m = 0;
+    size_t n = 0;
+    int rep = 0;
+    int threads = 0;
+    if (parseArguments(argc, argv, &m, &n, &rep, &threads) == -1) {
+        return 1;
+    }
+
+    printf("Matrix dimensions: %zu x %zu\n", m, n);
+    printf("Repetitions: %d\n", rep);
+    printf("Trials: %d (false accept probability at most %g)\n\n", FREIVALDS_TRIALS, pow(2, -FREIVALDS_TRIALS));
+
+    // Variables declaration
+    double ts, te, t1, t2, t3;       // execution times of the exact check, of the pre-filter and of the filtered check
+    bool symmetric = false;          // exact symmetry check
+    bool candidate = false;          // pre-filter
+    bool symmetric_filtered = false; // filtered symmetry check
+    double* M;                       // input matrix
+    double* T;                       // transposed matrix
+
+    // Matrices allocation
+    if (initMatrices(&M, &T, m, n) == -1) {
+        printf("Error in allocating matrices!\n\n");
+        return -1;
+    }
+
+    // Both checks read the whole matrix: the exact one by pairs of blocks, the pre-filter by rows
+    const double bytes = m * n * sizeof(double);
+
+    printf("Results: threads (T), symmetry (S), pre-filter (P), time in milliseconds of the exact symmetry check (E), of the pre-filter (F) ");
+    printf("and of the filtered symmetry check (EF), bandwidth in GB/s of the exact symmetry check (EB) and of the pre-filter (FB)\n\n");
+    printf("\t|\tT\t|\tS\t|\tP\t|\tE\t|\tF\t|\tEF\t|\tEB\t|\tFB\t|\n");
+
+    // Executions
+    for (int i = nextThreads(0, threads, true); i != 0; i = nextThreads(i, threads, true)) {  // the sequential and the passed threads
+        omp_set_num_threads(i);
+
+        ts = omp_get_wtime();
+        for (int j = 0; j < rep; j++) symmetric = checkSymOMP(M, m, n);
+        te = omp_get_wtime();
+        t1 = (te - ts) / rep;
+
+        ts = omp_get_wtime();
+        for (int j = 0; j < rep; j++) candidate = checkSymFreivalds(M, m, n);
+        te = omp_get_wtime();
+        t2 = (te - ts) / rep;
+
+        ts = omp_get_wtime();
+        for (int j = 0; j < rep; j++) symmetric_filtered = checkSymFiltered(M, m, n);
+        te = omp_get_wtime();
+        t3 = (te - ts) / rep;
+
+        // A symmetric matrix must always pass the pre-filter
+        if (symmetric && !candidate) printf("Error: the pre-filter rejected a symmetric matrix!\n");
+        if (symmetric != symmetric_filtered) printf("Error: the filtered check returned symmetry %d!\n", symmetric_filtered);
+
+        // Results printing and saving
+        double bandwidth1 = m == n ? bytes / t1 : 0;
+        double bandwidth2 = m == n ? bytes / t2 : 0;
+
+        printf("\t| %d\t\t| %d\t\t| %d\t\t| %8.4f\t| %8.4f\t| %8.4f\t| %8.4f\t| %8.4f\t|\n", i, symmetric, candidate, t1 * 1e3, t2 * 1e3, t3 * 1e3, bandwidth1 * 1e-9,
+               bandwidth2 * 1e-9);
+
+        if (saveResultsFreivalds(CODE, m, n, i, FREIVALDS_TRIALS, t1, t2, t3, bandwidth1, bandwidth2) == -1) {
+            printf("Error in saving results!\n\n");
+        }
+    }
+    // --------------------------------
+
+    printf("\n");
+    matTransposeOMP(M, T, m, n);
+    testResults(M, T, m, n);
+
+    // Matrices deallocation
+    free(M);
+    free(T);
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,206 @@
+#include <immintrin.h>
+#include <math.h>
+#include <omp.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "functions.h"
+#include "simd.h"
+
+#if defined(SIMD)
+#define CODE "OFV"
+#else
+#define CODE "OF"
+#endif
+
+#define BLOCK_SIZE 32
+
+// Separate kernels, sequential and OpenMP with the schedules of OB_D: each one reads the whole matrix
+bool checkSym(const double* M, size_t m, size_t n) {
+    if (m != n) return false;  // only square matrices can be symmetric
+    const size_t size = BLOCK_SIZE < n ? BLOCK_SIZE : n;
+    const size_t blocks = blockCount(n, size);
+    bool check = true;
+
+    for (size_t rb = 0; rb < blocks; rb++) {                 // row blocks indexing
+        for (size_t cb = 0; cb <= rb; cb++) {                // column blocks indexing
+            const double* first = M + (rb * n + cb) * size;  // block matrix of lower triangular part
+            const double* last = M + (cb * n + rb) * size;   // block matrix of higher triangular part
+            check &= checkBlock(first, last, n, blockLength(n, rb, size), blockLength(n, cb, size), rb == cb);
+        }
+    }
+
+    return check;
+}
+
+void matTranspose(const double* M, double* T, size_t m, size_t n) {
+    const size_t size = BLOCK_SIZE < n ? BLOCK_SIZE : n;
+    const size_t row_blocks = blockCount(m, size);
+    const size_t col_blocks = blockCount(n, size);
+
+    for (size_t rb = 0; rb < row_blocks; rb++) {      // row blocks indexing
+        for (size_t cb = 0; cb < col_blocks; cb++) {  // column blocks indexing
+            transposeBlock(M + (rb * n + cb) * size, n, T + (cb * m + rb) * size, m, blockLength(m, rb, size), blockLength(n, cb, size));
+        }
+    }
+}
+
+bool checkSymOMP(const double* M, size_t m, size_t n) {
+    if (m != n) return false;  // only square matrices can be symmetric
+    const size_t size = BLOCK_SIZE < n ? BLOCK_SIZE : n;
+    const size_t blocks = blockCount(n, size);
+    bool check = true;
+
+#pragma omp parallel for schedule(dynamic, 1) reduction(&& : check)
+    for (size_t rb = 0; rb < blocks; rb++) {                 // row blocks indexing
+        for (size_t cb = 0; cb <= rb; cb++) {                // column blocks indexing
+            const double* first = M + (rb * n + cb) * size;  // block matrix of lower triangular part
+            const double* last = M + (cb * n + rb) * size;   // block matrix of higher triangular part
+            check &= checkBlock(first, last, n, blockLength(n, rb, size), blockLength(n, cb, size), rb == cb);
+        }
+    }
+
+    return check;
+}
+
+void matTransposeOMP(const double* M, double* T, size_t m, size_t n) {
+    const size_t size = BLOCK_SIZE < n ? BLOCK_SIZE : n;
+    const size_t row_blocks = blockCount(m, size);
+    const size_t col_blocks = blockCount(n, size);
+
+#pragma omp parallel for collapse(2)
+    for (size_t rb = 0; rb < row_blocks; rb++) {      // row blocks indexing
+        for (size_t cb = 0; cb < col_blocks; cb++) {  // column blocks indexing
+            transposeBlock(M + (rb * n + cb) * size, n, T + (cb * m + rb) * size, m, blockLength(m, rb, size), blockLength(n, cb, size));
+        }
+    }
+}
+
+// Fused kernels: every pair of blocks (rb, cb) and (cb, rb) is read once, checked and written transposed in T,
+// where the blocks swap their positions. Rectangular matrices are never symmetric and are only transposed.
+bool checkSymTranspose(const double* M, double* T, size_t m, size_t n) {
+    if (m != n) {
+        matTranspose(M, T, m, n);
+        return false;
+    }
+    const size_t size = BLOCK_SIZE < n ? BLOCK_SIZE : n;
+    const size_t blocks = blockCount(n, size);
+    bool check = true;
+
+    for (size_t rb = 0; rb < blocks; rb++) {      // row blocks indexing
+        for (size_t cb = 0; cb <= rb; cb++) {     // column blocks indexing
+            const size_t first = (rb * n + cb) * size;  // offset of the block of lower triangular part
+            const size_t last = (cb * n + rb) * size;   // offset of the block of higher triangular part
+            check &= checkTransposeBlock(M + first, M + last, T + first, T + last, n, blockLength(n, rb, size), blockLength(n, cb, size), rb == cb);
+        }
+    }
+
+    return check;
+}
+
+bool checkSymTransposeOMP(const double* M, double* T, size_t m, size_t n) {
+    if (m != n) {
+        matTransposeOMP(M, T, m, n);
+        return false;
+    }
+    const size_t size = BLOCK_SIZE < n ? BLOCK_SIZE : n;
+    const size_t blocks = blockCount(n, size);
+    bool check = true;
+
+#pragma omp parallel for schedule(dynamic, 1) reduction(&& : check)
+    for (size_t rb = 0; rb < blocks; rb++) {      // row blocks indexing
+        for (size_t cb = 0; cb <= rb; cb++) {     // column blocks indexing
+            const size_t first = (rb * n + cb) * size;  // offset of the block of lower triangular part
+            const size_t last = (cb * n + rb) * size;   // offset of the block of higher triangular part
+            check &= checkTransposeBlock(M + first, M + last, T + first, T + last, n, blockLength(n, rb, size), blockLength(n, cb, size), rb == cb);
+        }
+    }
+
+    return check;
+}
+
+// The attribute is necessary to avoid the compiler optimization on the repetitions loops
+int __attribute__((optimize("O0"))) main(int argc, char** argv) {
+#ifdef _OPENMP
+    printf("Compiled with OpenMP %d.%02d\n", _OPENMP / 100, _OPENMP % 100);
+#else
+    printf("Error: compile with -fopenmp flag");
+#endif
+
+    size_t m = 0;
+    size_t n = 0;
+    int rep = 0;
+    int threads = 0;
+    if (parseArguments(argc, argv, &m, &n, &rep, &threads) == -1) {
+        return 1;
+    }
+
+    printf("Matrix dimensions: %zu x %zu\n", m, n);
+    printf("Repetitions: %d\n\n", rep);
+
+    // Variables declaration
+    double ts, te, t1, t2, t3;      // execution times of the separate kernels and of the fused one
+    bool symmetric = false;         // symmetry check of the separate kernels
+    bool symmetric_fused = false;   // symmetry check of the fused kernel
+    double* M;                      // input matrix
+    double* T;                      // transposed matrix
+
+    // Matrices allocation
+    if (initMatrices(&M, &T, m, n) == -1) {
+        printf("Error in allocating matrices!\n\n");
+        return -1;
+    }
+
+    // Bytes moved by the separate kernels (the symmetry check reads M, the transpose reads M and writes T) and by the fused one
+    const double bytes_separate = (m == n ? 3 : 2) * m * n * sizeof(double);
+    const double bytes_fused = 2 * m * n * sizeof(double);
+
+    printf("Results: threads (T), symmetry (S), time of the separate symmetry and transpose kernels (ST) and of the fused one (FT) in milliseconds, ");
+    printf("fused speedup (FS), bandwidth of the separate kernels (SB) and of the fused one (FB) in GB/s\n\n");
+    printf("\t|\tT\t|\tS\t|\tST\t|\tFT\t|\tFS\t|\tSB\t|\tFB\t|\n");
+
+    // Executions, 1 thread runs the sequential kernels
+    for (int i = nextThreads(0, threads, true); i != 0; i = nextThreads(i, threads, true)) {  // the sequential and the passed threads
+        omp_set_num_threads(i);
+
+        ts = omp_get_wtime();
+        for (int j = 0; j < rep; j++) symmetric = i == 1 ? checkSym(M, m, n) : checkSymOMP(M, m, n);
+        te = omp_get_wtime();
+        t1 = (te - ts) / rep;
+
+        ts = omp_get_wtime();
+        for (int j = 0; j < rep; j++) i == 1 ? matTranspose(M, T, m, n) : matTransposeOMP(M, T, m, n);
+        te = omp_get_wtime();
+        t2 = (te - ts) / rep;
+
+        ts = omp_get_wtime();
+        for (int j = 0; j < rep; j++) symmetric_fused = i == 1 ? checkSymTranspose(M, T, m, n) : checkSymTransposeOMP(M, T, m, n);
+        te = omp_get_wtime();
+        t3 = (te - ts) / rep;
+
+        if (symmetric != symmetric_fused) printf("Error: the fused kernel returned symmetry %d!\n", symmetric_fused);
+
+        // Results printing and saving
+        double speedup = (t1 + t2) / t3;
+        double bandwidth1 = bytes_separate / (t1 + t2);
+        double bandwidth2 = bytes_fused / t3;
+
+        printf("\t| %d\t\t| %d\t\t| %8.4f\t| %8.4f\t| %8.4f\t| %8.4f\t| %8.4f\t|\n", i, symmetric, (t1 + t2) * 1e3, t3 * 1e3, speedup, bandwidth1 * 1e-9, bandwidth2 * 1e-9);
+
+        if (saveResultsFused(CODE, m, n, i, t1 + t2, t3, bandwidth1, bandwidth2) == -1) {
+            printf("Error in saving results!\n\n");
+        }
+    }
+    // --------------------------------
+
+    printf("\n");
+    testResults(M, T, m, n);
+
+    // Matrices deallocation
+    free(M);
+    free(T);
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,204 @@
+#include <immintrin.h>
+#include <math.h>
+#include <omp.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "functions.h"
+
+#define CODE "OIP"
+
+#define BLOCK_SIZE 32
+
+bool checkSymOMP(const double* M, size_t m, size_t n) {
+    if (m != n) return false;  // only square matrices can be symmetric
+    const size_t size = BLOCK_SIZE < n ? BLOCK_SIZE : n / omp_get_num_threads();
+    const size_t blocks = blockCount(n, size);
+    bool check = true;
+
+#pragma omp parallel for schedule(dynamic, 1) reduction(&& : check)
+    for (size_t rb = 0; rb < blocks; rb++) {                 // row blocks indexing
+        const size_t rows = blockLength(n, rb, size);        // edge blocks can be smaller
+        for (size_t cb = 0; cb <= rb; cb++) {                // column blocks indexing
+            const size_t cols = blockLength(n, cb, size);
+            const double* first = M + (rb * n + cb) * size;  // block matrix of lower triangular part
+            const double* last = M + (cb * n + rb) * size;   // block matrix of higher triangular part
+            for (size_t i = 0; i < rows; i++) {              // symmetry check
+                for (size_t j = 0; j < cols; j++) {
+                    if (fabs(first[i * n + j] - last[j * n + i]) > EPSILON) {
+                        check = false;
+                    }
+                }
+            }
+        }
+    }
+
+    return check;
+}
+
+void matTransposeInPlaceOMP(double* M, size_t n) {
+    const size_t size = BLOCK_SIZE < n ? BLOCK_SIZE : n / omp_get_num_threads();
+    const size_t blocks = blockCount(n, size);
+
+    // every pair of blocks (rb, cb) and (cb, rb) is owned by a single thread, so no synchronization is needed
+#pragma omp parallel for schedule(dynamic, 1)
+    for (size_t rb = 0; rb < blocks; rb++) {               // row blocks indexing
+        const size_t rows = blockLength(n, rb, size);      // edge blocks can be smaller
+        double* diagonal = M + (rb * n + rb) * size;       // block matrix on the main diagonal
+        for (size_t i = 1; i < rows; i++) {                // transposing the diagonal block in place
+            for (size_t j = 0; j < i; j++) {
+                double tmp = diagonal[i * n + j];
+                diagonal[i * n + j] = diagonal[j * n + i];
+                diagonal[j * n + i] = tmp;
+            }
+        }
+
+        for (size_t cb = 0; cb < rb; cb++) {               // column blocks indexing
+            const size_t cols = blockLength(n, cb, size);
+            double* first = M + (rb * n + cb) * size;      // block matrix of lower triangular part
+            double* last = M + (cb * n + rb) * size;       // block matrix of higher triangular part
+            for (size_t i = 0; i < rows; i++) {            // swapping the transposed blocks
+                for (size_t j = 0; j < cols; j++) {
+                    double tmp = first[i * n + j];
+                    first[i * n + j] = last[j * n + i];
+                    last[j * n + i] = tmp;
+                }
+            }
+        }
+    }
+}
+
+// The attribute is necessary to avoid the compiler optimization on the repetitions loops
+int __attribute__((optimize("O0"))) main(int argc, char** argv) {
+#ifdef _OPENMP
+    printf("Compiled with OpenMP %d.%02d\n", _OPENMP / 100, _OPENMP % 100);
+#else
+    printf("Error: compile with -fopenmp flag");
+#endif
+
+    size_t m = 0;
+    size_t n = 0;
+    int rep = 0;
+    int threads = 0;
+    if (parseArguments(argc, argv, &m, &n, &rep, &threads) == -1) {
+        return 1;
+    }
+
+    printf("Matrix dimensions: %zu x %zu\n", m, n);
+    printf("Repetitions: %d\n\n", rep);
+
+    if (m != n) {
+        printf("In-place transpose requires a square matrix!\n\n");
+        return 1;
+    }
+
+    // Variables declaration
+    double ts1, ts2, te1, te2, t1, t2, s1, s2;  // execution times
+    bool symmetric = false;                     // symmetry check
+    double rows, cols;                          // checksums of the input matrix
+    int transpositions = 0;                     // number of in-place transpositions applied to M
+    double* M;                                  // input matrix, transposed in place
+    double* original;                           // copy of the input matrix for the verification
+
+    // Matrix allocation (no T buffer is needed)
+    if (initMatrix(&M, m, n) == -1) {
+        printf("Error in allocating matrices!\n\n");
+        return -1;
+    }
+    checksumMatrix(M, n, n, &rows, &cols);
+    original = keepOriginal(M, n);
+
+    omp_set_num_threads(1);
+
+    ts1 = omp_get_wtime();
+    for (int i = 0; i < rep; i++) symmetric = checkSymOMP(M, m, n);
+    te1 = omp_get_wtime();
+
+    ts2 = omp_get_wtime();
+    for (int i = 0; i < rep; i++) { matTransposeInPlaceOMP(M, n); transpositions++; }
+    te2 = omp_get_wtime();
+
+    s1 = (te1 - ts1) / rep;
+    s2 = (te2 - ts2) / rep;
+
+    printf("Sequential execution: symmetry: %s\n", symmetric ? "true" : "false");
+    printf("checkSymOMP:\t%.9f seconds\n", s1);
+    printf("matTransposeInPlaceOMP:%.9f seconds\n\n", s2);
+
+    printf("Results: threads (T), symmetry (S), ");
+    printf("symmetry speedup (SS), symmetry efficiency (SE), transpose speedup (TS), transpose efficiency (TE), transpose bandwidth in GB/s (TB) \n\n");
+    printf("\t|\tT\t|\tS\t|\tSS\t|\tSE\t|\tTS\t|\tTE\t|\tTB\t|\n");
+    
+    double bandwidth = 2 * m * n * sizeof(double) / (s2);
+    if (saveResultsOMP(CODE, m, n, 1, 1, 100, 1, 100, bandwidth) == -1) {
+        printf("Error in saving results!\n\n");
+    }
+
+    // Executions
+    if (threads == 0) {
+        for (int i = 2; i <= 64; i *= 2) {
+            omp_set_num_threads(i);
+
+            ts1 = omp_get_wtime();
+            for (int j = 0; j < rep; j++) symmetric = checkSymOMP(M, m, n);
+            te1 = omp_get_wtime();
+
+            ts2 = omp_get_wtime();
+            for (int j = 0; j < rep; j++) { matTransposeInPlaceOMP(M, n); transpositions++; }
+            te2 = omp_get_wtime();
+
+            // Results printing and saving
+            t1 = (te1 - ts1) / rep;
+            t2 = (te2 - ts2) / rep;
+
+            double speedup1 = (double)s1 / t1;
+            double efficiency1 = (double)speedup1 / i * 100;
+            double speedup2 = (double)s2 / t2;
+            double efficiency2 = (double)speedup2 / i * 100;
+            double bandwidth = 2 * m * n * sizeof(double) / (t2);
+
+            printf("\t| %d\t\t| %d\t\t| %8.4f\t| %8.4f\t| %8.4f\t| %8.4f\t| %8.4f\t|\n", i, symmetric, speedup1, efficiency1, speedup2, efficiency2, bandwidth * 1e-9);
+
+            if (saveResultsOMP(CODE, m, n, i, speedup1, efficiency1, speedup2, efficiency2, bandwidth) == -1) {
+                printf("Error in saving results!\n\n");
+            }
+        }
+    } else {
+        omp_set_num_threads(threads);
+        ts1 = omp_get_wtime();
+        for (int j = 0; j < rep; j++) symmetric = checkSymOMP(M, m, n);
+        te1 = omp_get_wtime();
+
+        ts2 = omp_get_wtime();
+        for (int j = 0; j < rep; j++) { matTransposeInPlaceOMP(M, n); transpositions++; }
+        te2 = omp_get_wtime();
+
+        // Results printing and saving
+        t1 = (te1 - ts1) / rep;
+        t2 = (te2 - ts2) / rep;
+
+        double speedup1 = (double)s1 / t1;
+        double efficiency1 = (double)speedup1 / threads * 100;
+        double speedup2 = (double)s2 / t2;
+        double efficiency2 = (double)speedup2 / threads * 100;
+        double bandwidth = 2 * m * n * sizeof(double) / (t2);
+
+        printf("\t| %d\t\t| %d\t\t| %8.4f\t| %8.4f\t| %8.4f\t| %8.4f\t| %8.4f\t|\n", threads, symmetric, speedup1, efficiency1, speedup2, efficiency2, bandwidth * 1e-9);
+
+        if (saveResultsOMP(CODE, m, n, threads, speedup1, efficiency1, speedup2, efficiency2, bandwidth) == -1) {
+            printf("Error in saving results!\n\n");
+        }
+    }
+    // --------------------------------
+
+    printf("\n");
+    testInPlace(M, original, n, rows, cols, transpositions % 2 == 1);
+
+    // Matrix deallocation
+    free(M);
+    free(original);
+
+    return 0;
+}
\ No newline at end of file
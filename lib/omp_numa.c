@@ -0,0 +1,398 @@
+#include <immintrin.h>
+#include <math.h>
+#include <omp.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "functions.h"
+#include "simd.h"
+
+#define CODE "ON"
+
+#define BLOCK_SIZE 32
+
+// Nodes above this value are treated as unknown
+#define MAX_NODES 64
+
+// NUMA node of the CPU running the calling thread, 0 when it cannot be queried
+int currentNode(void) {
+    unsigned int cpu, node;
+    return syscall(SYS_getcpu, &cpu, &node, NULL) == 0 ? (int)node : 0;
+}
+
+// NUMA nodes of the pages of a matrix, queried once with move_pages: the node of the page holding M[i] is
+// nodes[(address of M[i] - base) / page], -1 when it is unknown
+struct PageNodes {
+    uintptr_t base;  // address of the first page
+    size_t page;     // page size in bytes
+    size_t count;
+    int* nodes;
+};
+
+// Queries the nodes of all the pages of a matrix of m x n elements. Returns -1 if the arrays cannot be allocated
+int initPageNodes(struct PageNodes* pages, const double* M, size_t m, size_t n) {
+    pages->page = (size_t)sysconf(_SC_PAGESIZE);
+    pages->base = (uintptr_t)M & ~(uintptr_t)(pages->page - 1);
+    pages->count = ((uintptr_t)(M + m * n) - pages->base + pages->page - 1) / pages->page;
+    pages->nodes = (int*)malloc(pages->count * sizeof(int));
+    void** addresses = (void**)malloc(pages->count * sizeof(void*));
+    if (pages->nodes == NULL || addresses == NULL) {
+        free(pages->nodes);
+        free(addresses);
+        return -1;
+    }
+
+    for (size_t p = 0; p < pages->count; p++) addresses[p] = (void*)(pages->base + p * pages->page);
+    if (syscall(SYS_move_pages, 0, pages->count, addresses, NULL, pages->nodes, 0) != 0) {
+        for (size_t p = 0; p < pages->count; p++) pages->nodes[p] = -1;
+    }
+    for (size_t p = 0; p < pages->count; p++) {
+        if (pages->nodes[p] < 0 || pages->nodes[p] >= MAX_NODES) pages->nodes[p] = -1;  // errors are returned as negative values
+    }
+
+    free(addresses);
+    return 0;
+}
+
+// NUMA node of the page holding an element
+static inline int pageNode(const struct PageNodes* pages, const double* element) {
+    return pages->nodes[((uintptr_t)element - pages->base) / pages->page];
+}
+
+// Node holding most of the bytes of every block row (of side size) of a matrix with n columns, counted page by
+// page: -1 when most of them are on unknown nodes
+void blockRowNodes(const struct PageNodes* pages, const double* M, size_t m, size_t n, size_t size, size_t blocks, int* nodes) {
+    for (size_t b = 0; b < blocks; b++) {
+        size_t bytes[MAX_NODES] = {0};
+        size_t unknown = 0;
+        uintptr_t address = (uintptr_t)(M + b * size * n);
+        const uintptr_t end = (uintptr_t)(M + (b * size + blockLength(m, b, size)) * n);
+        while (address < end) {  // the first and last pages can be shared with the neighbouring block rows
+            const uintptr_t next = (address - pages->base) / pages->page * pages->page + pages->base + pages->page;
+            const size_t length = (next < end ? next : end) - address;
+            const int node = pageNode(pages, (const double*)address);
+            if (node == -1) unknown += length; else bytes[node] += length;
+            address = next;
+        }
+
+        nodes[b] = -1;
+        for (int node = 0; node < MAX_NODES; node++) {
+            if (bytes[node] > unknown && (nodes[b] == -1 || bytes[node] > bytes[nodes[b]])) nodes[b] = node;
+        }
+    }
+}
+
+// Assigns every block row to a thread: the block rows whose pages live on a node are split round robin among the
+// threads running on that node, the ones on nodes without threads (or on unknown nodes) among all the threads
+void assignBlockRows(const int* row_nodes, size_t blocks, const int* thread_nodes, int threads, int* owner) {
+    int next[MAX_NODES] = {0};  // position in the round robin of every node
+    size_t others = 0;          // position in the round robin of all the threads
+
+    for (size_t b = 0; b < blocks; b++) {
+        int node = row_nodes[b];
+        int count = 0;
+        for (int t = 0; t < threads && node != -1; t++) count += thread_nodes[t] == node;
+
+        if (count == 0) {
+            owner[b] = others++ % threads;
+            continue;
+        }
+
+        int k = next[node]++ % count;
+        for (int t = 0; t < threads; t++) {
+            if (thread_nodes[t] == node && k-- == 0) {
+                owner[b] = t;
+                break;
+            }
+        }
+    }
+}
+
+// Adds the bytes of a rows x cols block (row stride ld) to local if the page of each of its rows lives on node,
+// to remote otherwise. A row of a block is at most 256 bytes and is charged to the page of its first element
+void blockTraffic(const struct PageNodes* pages, const double* block, size_t ld, size_t rows, size_t cols, int node, double* local, double* remote) {
+    for (size_t i = 0; i < rows; i++) {
+        const double bytes = (double)(cols * sizeof(double));
+        if (node != -1 && pageNode(pages, block + i * ld) == node) *local += bytes; else *remote += bytes;
+    }
+}
+
+// Placement of the blocks on the threads for a matrix and a number of threads: the nodes of the block rows of M and T
+// and of the threads, the owner thread of every block row of M (for the check) and of T (for the transpose), and the
+// estimated local and remote traffic of one call of the kernels. It is computed once by initPlacement, outside of the
+// timed repetitions
+struct Placement {
+    int threads;
+    size_t row_blocks;     // block rows of M
+    size_t col_blocks;     // block rows of T
+    int* source_nodes;     // nodes of the block rows of M
+    int* destination_nodes;// nodes of the block rows of T
+    int* thread_nodes;     // nodes of the threads
+    int* check_owner;      // owner threads of the block rows of M
+    int* transpose_owner;  // owner threads of the block rows of T
+    double local_check, remote_check;          // estimated bytes of a symmetry check on the node of the reading thread or not
+    double local_transpose, remote_transpose;  // estimated bytes of a transpose on the node of the accessing thread or not
+};
+
+void freePlacement(struct Placement* placement) {
+    free(placement->source_nodes);
+    free(placement->destination_nodes);
+    free(placement->thread_nodes);
+    free(placement->check_owner);
+    free(placement->transpose_owner);
+}
+
+// Estimates the traffic of the kernels from the node of the page of every row of every block they access and the
+// node of the owner thread. It is a model of the page placement, not a measure: cache hits, prefetches and the
+// read-for-ownership of the stores are not counted
+void estimateTraffic(struct Placement* placement, const struct PageNodes* source, const struct PageNodes* destination,
+                     const double* M, const double* T, size_t m, size_t n) {
+    const size_t size = BLOCK_SIZE < n ? BLOCK_SIZE : n;
+    placement->local_check = placement->remote_check = 0;
+    placement->local_transpose = placement->remote_transpose = 0;
+
+    for (size_t rb = 0; rb < placement->row_blocks && m == n; rb++) {  // only square matrices are checked
+        const int node = placement->thread_nodes[placement->check_owner[rb]];
+        const size_t rows = blockLength(n, rb, size);
+        for (size_t cb = 0; cb <= rb; cb++) {
+            const size_t cols = blockLength(n, cb, size);
+            blockTraffic(source, M + (rb * n + cb) * size, n, rows, cols, node, &placement->local_check, &placement->remote_check);
+            blockTraffic(source, M + (cb * n + rb) * size, n, cols, rows, node, &placement->local_check, &placement->remote_check);
+        }
+    }
+
+    for (size_t cb = 0; cb < placement->col_blocks; cb++) {
+        const int node = placement->thread_nodes[placement->transpose_owner[cb]];
+        const size_t cols = blockLength(n, cb, size);
+        for (size_t rb = 0; rb < placement->row_blocks; rb++) {
+            const size_t rows = blockLength(m, rb, size);
+            blockTraffic(source, M + (rb * n + cb) * size, n, rows, cols, node, &placement->local_transpose, &placement->remote_transpose);
+            blockTraffic(destination, T + (cb * m + rb) * size, m, cols, rows, node, &placement->local_transpose, &placement->remote_transpose);
+        }
+    }
+}
+
+// Queries the nodes of all the pages of M (m x n) and T and of the threads, assigns the block rows to the threads and
+// estimates the traffic. Returns -1 if the arrays cannot be allocated
+int initPlacement(struct Placement* placement, const double* M, const double* T, size_t m, size_t n, int threads) {
+    const size_t size = BLOCK_SIZE < n ? BLOCK_SIZE : n;
+    struct PageNodes source, destination;
+    placement->threads = threads;
+    placement->row_blocks = blockCount(m, size);
+    placement->col_blocks = blockCount(n, size);
+    placement->source_nodes = (int*)malloc(placement->row_blocks * sizeof(int));
+    placement->destination_nodes = (int*)malloc(placement->col_blocks * sizeof(int));
+    placement->thread_nodes = (int*)malloc(threads * sizeof(int));
+    placement->check_owner = (int*)malloc(placement->row_blocks * sizeof(int));
+    placement->transpose_owner = (int*)malloc(placement->col_blocks * sizeof(int));
+    if (placement->source_nodes == NULL || placement->destination_nodes == NULL || placement->thread_nodes == NULL ||
+        placement->check_owner == NULL || placement->transpose_owner == NULL) {
+        freePlacement(placement);
+        return -1;
+    }
+    if (initPageNodes(&source, M, m, n) == -1) {
+        freePlacement(placement);
+        return -1;
+    }
+    if (initPageNodes(&destination, T, n, m) == -1) {
+        free(source.nodes);
+        freePlacement(placement);
+        return -1;
+    }
+
+    blockRowNodes(&source, M, m, n, size, placement->row_blocks, placement->source_nodes);
+    blockRowNodes(&destination, T, n, m, size, placement->col_blocks, placement->destination_nodes);
+
+    for (int t = 0; t < threads; t++) placement->thread_nodes[t] = -1;
+#pragma omp parallel num_threads(threads)
+    placement->thread_nodes[omp_get_thread_num()] = currentNode();  // threads must be bound to their cores (OMP_PROC_BIND) to stay on the node
+
+    assignBlockRows(placement->source_nodes, placement->row_blocks, placement->thread_nodes, threads, placement->check_owner);
+    assignBlockRows(placement->destination_nodes, placement->col_blocks, placement->thread_nodes, threads, placement->transpose_owner);
+    estimateTraffic(placement, &source, &destination, M, T, m, n);
+
+    free(source.nodes);
+    free(destination.nodes);
+    return 0;
+}
+
+// Each thread checks the block rows of the lower triangular part whose pages live on its own node,
+// the mirrored blocks in the higher triangular part can be remote
+bool checkSymOMP(const double* M, size_t m, size_t n, const struct Placement* placement) {
+    if (m != n) return false;  // only square matrices can be symmetric
+    const size_t size = BLOCK_SIZE < n ? BLOCK_SIZE : n;
+    const size_t blocks = placement->row_blocks;
+    bool check = true;
+
+#pragma omp parallel num_threads(placement->threads) reduction(&& : check)
+    {
+        const int id = omp_get_thread_num();
+        const int team = omp_get_num_threads();  // a smaller team takes over the block rows of the missing threads
+        bool c = true;
+
+        for (size_t rb = 0; rb < blocks; rb++) {               // row blocks indexing
+            if (placement->check_owner[rb] % team != id) continue;
+            for (size_t cb = 0; cb <= rb; cb++) {              // column blocks indexing
+                const double* first = M + (rb * n + cb) * size;  // block matrix of lower triangular part
+                const double* last = M + (cb * n + rb) * size;   // block matrix of higher triangular part
+                c &= checkBlock(first, last, n, blockLength(n, rb, size), blockLength(n, cb, size), rb == cb);  // same tile kernel as OB
+            }
+        }
+
+        check = check && c;
+    }
+
+    return check;
+}
+
+// Each thread writes the block rows of T whose pages live on its own node, so that the stores (and the reads for
+// ownership of their cache lines) stay local while the loads from M can be remote
+void matTransposeOMP(const double* M, double* T, size_t m, size_t n, const struct Placement* placement) {
+    const size_t size = BLOCK_SIZE < n ? BLOCK_SIZE : n;
+    const size_t row_blocks = placement->row_blocks;
+    const size_t col_blocks = placement->col_blocks;
+
+#pragma omp parallel num_threads(placement->threads)
+    {
+        const int id = omp_get_thread_num();
+        const int team = omp_get_num_threads();  // a smaller team takes over the block rows of the missing threads
+
+        for (size_t cb = 0; cb < col_blocks; cb++) {           // column blocks of M, row blocks of T
+            if (placement->transpose_owner[cb] % team != id) continue;
+            for (size_t rb = 0; rb < row_blocks; rb++) {       // row blocks of M, column blocks of T
+                const double* source = M + (rb * n + cb) * size;
+                double* destination = T + (cb * m + rb) * size;
+                transposeBlock(source, n, destination, m, blockLength(m, rb, size), blockLength(n, cb, size));  // same tile kernel as OB
+            }
+        }
+    }
+}
+
+// Estimated percentage of the traffic on the local node, 0 when nothing was accessed (e.g. rectangular matrices are not checked)
+double localPercentage(double local, double remote) {
+    return local + remote > 0 ? local / (local + remote) * 100 : 0;
+}
+
+// The attribute is necessary to avoid the compiler optimization on the repetitions loops
+int __attribute__((optimize("O0"))) main(int argc, char** argv) {
+#ifdef _OPENMP
+    printf("Compiled with OpenMP %d.%02d\n", _OPENMP / 100, _OPENMP % 100);
+#else
+    printf("Error: compile with -fopenmp flag");
+#endif
+
+    size_t m = 0;
+    size_t n = 0;
+    int rep = 0;
+    int threads = 0;
+    if (parseArguments(argc, argv, &m, &n, &rep, &threads) == -1) {
+        return 1;
+    }
+
+    printf("Matrix dimensions: %zu x %zu\n", m, n);
+    printf("Repetitions: %d\n\n", rep);
+
+    // Variables declaration
+    double ts1, ts2, te1, te2, t1, t2, s1, s2;  // execution times
+    double local1, remote1, local2, remote2;    // estimated local and remote traffic per repetition in bytes
+    bool symmetric = false;                     // symmetry check
+    struct Placement placement;                 // block rows of the threads
+    double* M;                                  // input matrix
+    double* T;                                  // transposed matrix
+
+    // Matrices allocation, first touched in parallel by all the threads
+    if (initMatrices(&M, &T, m, n) == -1) {
+        printf("Error in allocating matrices!\n\n");
+        return -1;
+    }
+
+    omp_set_num_threads(1);
+    if (initPlacement(&placement, M, T, m, n, 1) == -1) {
+        printf("Error in allocating matrices!\n\n");
+        return -1;
+    }
+
+    ts1 = omp_get_wtime();
+    for (int i = 0; i < rep; i++) symmetric = checkSymOMP(M, m, n, &placement);
+    te1 = omp_get_wtime();
+
+    ts2 = omp_get_wtime();
+    for (int i = 0; i < rep; i++) matTransposeOMP(M, T, m, n, &placement);
+    te2 = omp_get_wtime();
+    local1 = placement.local_check;
+    remote1 = placement.remote_check;
+    local2 = placement.local_transpose;
+    remote2 = placement.remote_transpose;
+    freePlacement(&placement);
+
+    s1 = (te1 - ts1) / rep;
+    s2 = (te2 - ts2) / rep;
+
+    printf("Sequential execution: symmetry: %s\n", symmetric ? "true" : "false");
+    printf("checkSymOMP:\t%.9f seconds\n", s1);
+    printf("matTransposeOMP:%.9f seconds\n\n", s2);
+
+    printf("Results: threads (T), symmetry (S), ");
+    printf("symmetry speedup (SS), symmetry efficiency (SE), transpose speedup (TS), transpose efficiency (TE), transpose bandwidth in GB/s (TB), ");
+    printf("estimated local traffic percentage of symmetry (LS) and transpose (LT)\n\n");
+    printf("\t|\tT\t|\tS\t|\tSS\t|\tSE\t|\tTS\t|\tTE\t|\tTB\t|\tLS\t|\tLT\t|\n");
+
+    double bandwidth = 2 * m * n * sizeof(double) / (s2);
+    printf("\t| 1\t\t| %d\t\t| %8.4f\t| %8.4f\t| %8.4f\t| %8.4f\t| %8.4f\t| %8.2f\t| %8.2f\t|\n", symmetric, 1.0, 100.0, 1.0, 100.0, bandwidth * 1e-9,
+           localPercentage(local1, remote1), localPercentage(local2, remote2));
+
+    if (saveResultsOMP(CODE, m, n, 1, 1, 100, 1, 100, bandwidth) == -1 || saveResultsNUMA(CODE, m, n, 1, local1, remote1, local2, remote2) == -1) {
+        printf("Error in saving results!\n\n");
+    }
+
+    // Executions
+    for (int i = nextThreads(0, threads, false); i != 0; i = nextThreads(i, threads, false)) {  // the passed threads
+        omp_set_num_threads(i);
+        if (initPlacement(&placement, M, T, m, n, i) == -1) {  // the pages and the threads are placed before the timing
+            printf("Error in allocating matrices!\n\n");
+            return -1;
+        }
+
+        ts1 = omp_get_wtime();
+        for (int j = 0; j < rep; j++) symmetric = checkSymOMP(M, m, n, &placement);
+        te1 = omp_get_wtime();
+
+        ts2 = omp_get_wtime();
+        for (int j = 0; j < rep; j++) matTransposeOMP(M, T, m, n, &placement);
+        te2 = omp_get_wtime();
+        local1 = placement.local_check;
+        remote1 = placement.remote_check;
+        local2 = placement.local_transpose;
+        remote2 = placement.remote_transpose;
+        freePlacement(&placement);
+
+        // Results printing and saving
+        t1 = (te1 - ts1) / rep;
+        t2 = (te2 - ts2) / rep;
+
+        double speedup1 = (double)s1 / t1;
+        double efficiency1 = (double)speedup1 / i * 100;
+        double speedup2 = (double)s2 / t2;
+        double efficiency2 = (double)speedup2 / i * 100;
+        double bandwidth = 2 * m * n * sizeof(double) / (t2);
+
+        printf("\t| %d\t\t| %d\t\t| %8.4f\t| %8.4f\t| %8.4f\t| %8.4f\t| %8.4f\t| %8.2f\t| %8.2f\t|\n", i, symmetric, speedup1, efficiency1, speedup2, efficiency2, bandwidth * 1e-9,
+               localPercentage(local1, remote1), localPercentage(local2, remote2));
+
+        if (saveResultsOMP(CODE, m, n, i, speedup1, efficiency1, speedup2, efficiency2, bandwidth) == -1 || saveResultsNUMA(CODE, m, n, i, local1, remote1, local2, remote2) == -1) {
+            printf("Error in saving results!\n\n");
+        }
+    }
+    // --------------------------------
+
+    printf("\n");
+    testResults(M, T, m, n);
+
+    // Matrices deallocation
+    free(M);
+    free(T);
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,321 @@
+#include <fcntl.h>
+#include <immintrin.h>
+#include <math.h>
+#include <omp.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "functions.h"
+#include "simd.h"
+
+#define CODE "OOC"
+
+#define BLOCK_SIZE 32
+
+// Memory budget in MiB of the bands, below the 512 MB requested by start.pbs. It can be changed at run time with the
+// OOC_BUDGET environment variable
+#define OOC_BUDGET 256
+
+// Doubles in a page: column bands multiple of it read every page of the input once
+#define PAGE_DOUBLES 512
+
+// Matrix files of the input matrix (generated when --input is not passed) and of the transposed one (kept when
+// --output is passed)
+#define OOC_INPUT_FILE "ooc_input.bin"
+#define OOC_OUTPUT_FILE "ooc_transposed.bin"
+
+// Writes the workload matrix to the matrix file at path by bands of rows, without holding it in memory
+int writeMatrixFile(const char* path, size_t m, size_t n, size_t budget) {
+    struct MatrixHeader header = {MATRIX_FILE_MAGIC, MATRIX_FILE_VERSION, MATRIX_F64, MATRIX_ROW_MAJOR, sizeof(double), m, n, n, MATRIX_FILE_ALIGNMENT, 0};
+    const size_t rows = budget / (n * sizeof(double)) > 0 ? budget / (n * sizeof(double)) : 1;
+    double* band = allocMatrix(rows < m ? rows : m, n);
+    int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+    if (band == NULL || fd == -1 || transferAll(fd, &header, sizeof(header), 0, true) == -1) {
+        free(band);
+        if (fd != -1) close(fd);
+        return -1;
+    }
+
+    for (size_t r0 = 0; r0 < m; r0 += rows) {
+        const size_t h = r0 + rows < m ? rows : m - r0;
+#pragma omp parallel for schedule(static)
+        for (size_t i = 0; i < h; i++) {
+            for (size_t j = 0; j < n; j++) band[i * n + j] = workloadValue(&workload, r0 + i, j);
+        }
+
+        if (workload.kind == WORKLOAD_PERTURBED && m > 1) {
+            for (size_t p = 0; p < workload.perturbations; p++) {
+                size_t i, j;
+                perturbationPosition(&workload, p, m, n, &i, &j);
+                if (i >= r0 && i < r0 + h) band[(i - r0) * n + j] += 1;
+            }
+        }
+
+        if (transferAll(fd, band, h * n * sizeof(double), header.offset + r0 * n * sizeof(double), true) == -1) {
+            free(band);
+            close(fd);
+            return -1;
+        }
+    }
+
+    free(band);
+    return close(fd);
+}
+
+// Drops the pages of a file from the page cache, so that the next repetition reads it from the disk
+void dropCache(int fd) {
+    fdatasync(fd);
+    posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+}
+
+// Advises the kernel on the pages of [start, start + bytes), aligned down to the page containing start
+void adviseRange(const void* start, size_t bytes, int advice) {
+    const size_t page = sysconf(_SC_PAGESIZE);
+    const size_t offset = (size_t)start % page;
+    madvise((char*)start - offset, bytes + offset, advice);
+}
+
+// Symmetry check of the mapped square matrix M by bands of rows: the band I is checked against the blocks of the
+// higher triangular part in its columns, like the blocked kernels, so that every element is read once. Two bands fit
+// in the budget: the next band of rows is prefetched while the current one is checked, and the pages of the mapping
+// are released after every band. The check stops at the first band with a difference, the rows checked until then
+// are returned in checked: the leading checked x checked square of M was read.
+bool checkSymOutOfCore(const double* M, size_t m, size_t n, size_t budget, size_t* checked) {
+    *checked = 0;
+    if (m != n) return false;  // only square matrices can be symmetric
+    const size_t size = BLOCK_SIZE < n ? BLOCK_SIZE : n;
+    size_t height = budget / (2 * n * sizeof(double)) / size * size;  // rows of a band, multiple of the blocks
+    if (height < size) height = size;
+    bool check = true;
+
+    madvise((void*)M, n * n * sizeof(double), MADV_RANDOM);  // the higher triangular part is read by segments of rows
+    adviseRange(M, (height < n ? height : n) * n * sizeof(double), MADV_WILLNEED);
+
+    for (size_t r0 = 0; r0 < n && check; r0 += height) {
+        const size_t first_block = r0 / size;
+        const size_t last_block = blockCount(r0 + height < n ? r0 + height : n, size);
+        if (r0 + height < n) adviseRange(M + (r0 + height) * n, (r0 + 2 * height < n ? height : n - r0 - height) * n * sizeof(double), MADV_WILLNEED);
+
+#pragma omp parallel for schedule(dynamic, 1) reduction(&& : check)
+        for (size_t rb = first_block; rb < last_block; rb++) {   // row blocks of the band
+            for (size_t cb = 0; cb <= rb; cb++) {                // column blocks indexing
+                const double* first = M + (rb * n + cb) * size;  // block matrix of lower triangular part
+                const double* last = M + (cb * n + rb) * size;   // block matrix of higher triangular part
+                check &= checkBlock(first, last, n, blockLength(n, rb, size), blockLength(n, cb, size), rb == cb);
+            }
+        }
+
+        madvise((void*)M, n * n * sizeof(double), MADV_DONTNEED);  // the mapping is read only, its pages are clean
+        *checked = r0 + height < n ? r0 + height : n;
+    }
+
+    return check;
+}
+
+// Transpose of the mapped matrix M (m x n) into the file fd, with the payload at offset, by bands of columns of M,
+// i.e. of rows of T: every band is transposed in memory by blocks in parallel and written to the file with a single
+// large sequential write. Bands multiple of a page read every page of the input once. Returns -1 if a write fails.
+int matTransposeOutOfCore(const double* M, int fd, off_t offset, size_t m, size_t n, size_t budget) {
+    const size_t size = BLOCK_SIZE < n ? BLOCK_SIZE : n;
+    size_t width = budget / (m * sizeof(double));  // columns of a band
+    width = width >= PAGE_DOUBLES ? width / PAGE_DOUBLES * PAGE_DOUBLES : width / size * size;
+    if (width < size) width = size;
+    if (width > n) width = n;
+    double* band = allocMatrix(width, m);
+    int result = 0;
+
+    if (band == NULL) return -1;
+
+    // Rows are read by segments of the band: readahead would load the pages of the following bands
+    madvise((void*)M, m * n * sizeof(double), width >= PAGE_DOUBLES ? MADV_RANDOM : MADV_NORMAL);
+
+    for (size_t c0 = 0; c0 < n && result == 0; c0 += width) {
+        const size_t w = c0 + width < n ? width : n - c0;
+        const size_t row_blocks = blockCount(m, size);
+        const size_t col_blocks = blockCount(w, size);
+
+#pragma omp parallel for schedule(static)
+        for (size_t rb = 0; rb < row_blocks; rb++) {      // row blocks indexing
+            for (size_t cb = 0; cb < col_blocks; cb++) {  // column blocks of the band
+                transposeBlock(M + rb * size * n + c0 + cb * size, n, band + (cb * m + rb) * size, m, blockLength(m, rb, size), blockLength(w, cb, size));
+            }
+        }
+
+        if (transferAll(fd, band, w * m * sizeof(double), offset + c0 * m * sizeof(double), true) == -1) result = -1;
+        madvise((void*)M, m * n * sizeof(double), MADV_DONTNEED);
+    }
+
+    free(band);
+    return fdatasync(fd) == 0 ? result : -1;
+}
+
+// Kernels of OB on the matrices loaded in memory, for the comparison when they fit in the budget
+bool checkSymOMP(const double* M, size_t m, size_t n) {
+    if (m != n) return false;  // only square matrices can be symmetric
+    const size_t size = BLOCK_SIZE < n ? BLOCK_SIZE : n;
+    const size_t blocks = blockCount(n, size);
+    bool check = true;
+
+#pragma omp parallel for schedule(dynamic, 1) reduction(&& : check)
+    for (size_t rb = 0; rb < blocks; rb++) {                 // row blocks indexing
+        for (size_t cb = 0; cb <= rb; cb++) {                // column blocks indexing
+            const double* first = M + (rb * n + cb) * size;  // block matrix of lower triangular part
+            const double* last = M + (cb * n + rb) * size;   // block matrix of higher triangular part
+            check &= checkBlock(first, last, n, blockLength(n, rb, size), blockLength(n, cb, size), rb == cb);
+        }
+    }
+
+    return check;
+}
+
+void matTransposeOMP(const double* M, double* T, size_t m, size_t n) {
+    const size_t size = BLOCK_SIZE < n ? BLOCK_SIZE : n;
+    const size_t row_blocks = blockCount(m, size);
+    const size_t col_blocks = blockCount(n, size);
+
+#pragma omp parallel for collapse(2)
+    for (size_t rb = 0; rb < row_blocks; rb++) {      // row blocks indexing
+        for (size_t cb = 0; cb < col_blocks; cb++) {  // column blocks indexing
+            transposeBlock(M + (rb * n + cb) * size, n, T + (cb * m + rb) * size, m, blockLength(m, rb, size), blockLength(n, cb, size));
+        }
+    }
+}
+
+// The attribute is necessary to avoid the compiler optimization on the repetitions loops
+int __attribute__((optimize("O0"))) main(int argc, char** argv) {
+#ifdef _OPENMP
+    printf("Compiled with OpenMP %d.%02d\n", _OPENMP / 100, _OPENMP % 100);
+#else
+    printf("Error: compile with -fopenmp flag");
+#endif
+
+    size_t m = 0;
+    size_t n = 0;
+    int rep = 0;
+    int threads = 0;
+    if (parseArguments(argc, argv, &m, &n, &rep, &threads) == -1) {
+        return 1;
+    }
+    if (threads != 0) omp_set_num_threads(threads);  // all the cores by default
+
+    const size_t budget = (getenv("OOC_BUDGET") != NULL && atol(getenv("OOC_BUDGET")) > 0 ? atol(getenv("OOC_BUDGET")) : OOC_BUDGET) * 1024 * 1024;
+    const char* input = inputFile != NULL ? inputFile : OOC_INPUT_FILE;
+    const char* output = outputFile != NULL ? outputFile : OOC_OUTPUT_FILE;
+    const bool keep = outputFile != NULL;
+    const size_t bytes = m * n * sizeof(double);
+    outputFile = NULL;  // T is written by the transpose, not by testResults
+
+    printf("Matrix dimensions: %zu x %zu (%.3f GB)\n", m, n, bytes * 1e-9);
+    printf("Repetitions: %d\n", rep);
+    printf("Threads: %d\n", omp_get_max_threads());
+    printf("Memory budget: %zu MiB\n", budget / 1024 / 1024);
+    printf("Input file: %s, transposed file: %s\n\n", input, output);
+
+    // Variables declaration
+    double ts, te, t1, t2, t3 = 0, t4 = 0;  // execution times out of core and in memory
+    bool symmetric = false;                 // symmetry check
+    size_t checked = 0;                     // rows read by the symmetry check out of core
+    double* M;                              // input matrix in memory
+    double* T;                              // transposed matrix in memory
+    struct MatrixHeader header;             // header of the input file
+    struct MatrixHeader transposed_header = {MATRIX_FILE_MAGIC, MATRIX_FILE_VERSION, MATRIX_F64, MATRIX_ROW_MAJOR, sizeof(double), n, m, m, MATRIX_FILE_ALIGNMENT, 0};
+
+    // Files creation and mapping
+    if (inputFile == NULL && writeMatrixFile(input, m, n, budget) == -1) {
+        printf("Error in writing the input file!\n\n");
+        return -1;
+    }
+    if (readMatrixHeader(input, &header) == -1 || header.type != MATRIX_F64 || header.layout != MATRIX_ROW_MAJOR || header.ld != n) {
+        printf("Unsupported input file %s: only row-major double matrices without padding can be mapped\n\n", input);
+        return -1;
+    }
+    int in = open(input, O_RDONLY);
+    int out = open(output, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (in == -1 || out == -1 || lseek(in, 0, SEEK_END) < (off_t)(header.offset + bytes) || transferAll(out, &transposed_header, sizeof(transposed_header), 0, true) == -1 ||
+        ftruncate(out, transposed_header.offset + bytes) == -1) {
+        printf("Error in opening the files!\n\n");
+        return -1;
+    }
+    const double* mapped = mmap(NULL, bytes, PROT_READ, MAP_SHARED, in, header.offset);
+    if (mapped == MAP_FAILED) {
+        printf("Error in mapping the input file!\n\n");
+        return -1;
+    }
+
+    // Executions, every repetition reads the input from the disk
+    ts = 0;
+    for (int j = 0; j < rep; j++) {
+        dropCache(in);
+        double start = omp_get_wtime();
+        symmetric = checkSymOutOfCore(mapped, m, n, budget, &checked);
+        ts += omp_get_wtime() - start;
+    }
+    t1 = ts / rep;
+
+    ts = 0;
+    for (int j = 0; j < rep; j++) {
+        dropCache(in);
+        dropCache(out);
+        double start = omp_get_wtime();
+        if (matTransposeOutOfCore(mapped, out, transposed_header.offset, m, n, budget) == -1) {
+            printf("Error in writing the transposed file!\n\n");
+            return -1;
+        }
+        ts += omp_get_wtime() - start;
+    }
+    t2 = ts / rep;
+
+    // In memory kernels of OB, when both matrices fit in the budget
+    if (2 * bytes <= budget && initMatrices(&M, &T, m, n) == 0) {
+        ts = omp_get_wtime();
+        for (int j = 0; j < rep; j++) checkSymOMP(M, m, n);
+        te = omp_get_wtime();
+        t3 = (te - ts) / rep;
+
+        ts = omp_get_wtime();
+        for (int j = 0; j < rep; j++) matTransposeOMP(M, T, m, n);
+        te = omp_get_wtime();
+        t4 = (te - ts) / rep;
+
+        free(M);
+        free(T);
+    }
+
+    // Results printing and saving, the symmetry check out of core stops at the first band with a difference
+    double bandwidth1 = (double)checked * checked * sizeof(double) / t1;
+    double bandwidth2 = 2 * bytes / t2;
+    double bandwidth3 = t3 > 0 && m == n ? bytes / t3 : 0;
+    double bandwidth4 = t4 > 0 ? 2 * bytes / t4 : 0;
+
+    printf("Results: threads (T), symmetry (S), I/O bandwidth in GB/s of the symmetry check (SB) and of the transpose (TB) out of core, ");
+    printf("bandwidth in GB/s of the symmetry check (SM) and of the transpose (TM) in memory (0 if the matrices do not fit in the budget)\n\n");
+    printf("\t|\tT\t|\tS\t|\tSB\t|\tTB\t|\tSM\t|\tTM\t|\n");
+    printf("\t| %d\t\t| %d\t\t| %8.4f\t| %8.4f\t| %8.4f\t| %8.4f\t|\n", omp_get_max_threads(), symmetric, bandwidth1 * 1e-9, bandwidth2 * 1e-9, bandwidth3 * 1e-9,
+           bandwidth4 * 1e-9);
+
+    if (saveResultsOutOfCore(CODE, m, n, omp_get_max_threads(), budget, t1, t2, bandwidth1, bandwidth2, bandwidth3, bandwidth4) == -1) {
+        printf("Error in saving results!\n\n");
+    }
+    // --------------------------------
+
+    printf("\n");
+    const double* transposed = mmap(NULL, bytes, PROT_READ, MAP_SHARED, out, transposed_header.offset);
+    if (transposed != MAP_FAILED) {
+        testResults((double*)mapped, (double*)transposed, m, n);
+        munmap((void*)transposed, bytes);
+    }
+
+    // Files unmapping and removal
+    munmap((void*)mapped, bytes);
+    close(in);
+    close(out);
+    if (inputFile == NULL) unlink(input);
+    if (!keep) unlink(output);
+
+    return 0;
+}
\ No newline at end of file
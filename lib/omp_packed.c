@@ -0,0 +1,148 @@
+#include <immintrin.h>
+#include <math.h>
+#include <omp.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "functions.h"
+#include "packed.h"
+
+#define CODE "OPK"
+
+#define BLOCK_SIZE 32
+
+// Transpose of OB on the full matrix, the cost avoided by the view of a packed symmetric matrix
+void matTransposeOMP(const double* M, double* T, size_t m, size_t n) {
+    const size_t size = BLOCK_SIZE < n ? BLOCK_SIZE : n;
+    const size_t row_blocks = blockCount(m, size);
+    const size_t col_blocks = blockCount(n, size);
+
+#pragma omp parallel for collapse(2)
+    for (size_t rb = 0; rb < row_blocks; rb++) {      // row blocks indexing
+        for (size_t cb = 0; cb < col_blocks; cb++) {  // column blocks indexing
+            transposeBlock(M + (rb * n + cb) * size, n, T + (cb * m + rb) * size, m, blockLength(m, rb, size), blockLength(n, cb, size));
+        }
+    }
+}
+
+// Checks that U is the symmetric matrix unpacked from the lower triangular part of M and that the transposed view
+// of the packed matrix P reads the same elements
+bool isUnpackOf(const double* M, const double* U, const double* P, size_t n, int layout) {
+    const double* PT = matTransposePacked(P, n, layout);
+    bool equal = true;
+
+#pragma omp parallel for schedule(dynamic, 1) reduction(&& : equal)
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = 0; j <= i; j++) {
+            if (U[i * n + j] != M[i * n + j] || U[j * n + i] != M[i * n + j] || packedElement(PT, n, layout, j, i) != M[i * n + j]) equal = false;
+        }
+    }
+
+    return equal;
+}
+
+// The attribute is necessary to avoid the compiler optimization on the repetitions loops
+int __attribute__((optimize("O0"))) main(int argc, char** argv) {
+#ifdef _OPENMP
+    printf("Compiled with OpenMP %d.%02d\n", _OPENMP / 100, _OPENMP % 100);
+#else
+    printf("Error: compile with -fopenmp flag");
+#endif
+
+    size_t m = 0;
+    size_t n = 0;
+    int rep = 0;
+    int threads = 0;
+    if (parseArguments(argc, argv, &m, &n, &rep, &threads) == -1) {
+        return 1;
+    }
+    if (m != n) {
+        printf("Error: packed storage needs a square matrix!\n\n");
+        return 1;
+    }
+
+    printf("Matrix dimensions: %zu x %zu\n", m, n);
+    printf("Repetitions: %d\n", rep);
+    printf("Packed size: %zu doubles instead of %zu (%.1f%%)\n\n", packedSize(n), n * n, 100.0 * packedSize(n) / (n * n));
+
+    // Variables declaration
+    double ts, te, t1, t2, t3, t4;                    // execution times
+    bool symmetric = false;                           // symmetry check of the packing
+    const char* layouts[] = {"lower", "rfp"};         // names of the packed layouts
+    double* M;                                        // input matrix
+    double* T;                                        // transposed matrix
+    double* P = allocMatrix(packedSize(n), 1);        // packed matrix
+    double* U = allocMatrix(n, n);                    // unpacked matrix
+
+    // Matrices allocation
+    if (initMatrices(&M, &T, m, n) == -1 || P == NULL || U == NULL) {
+        printf("Error in allocating matrices!\n\n");
+        return -1;
+    }
+
+    // Bytes moved by the packing, which reads the lower triangular part (the whole matrix when verifying) and writes
+    // the packed one, and by the unpacking, which reads the packed matrix and writes the whole one
+    const double bytes_pack = 2 * packedSize(n) * sizeof(double);
+    const double bytes_unpack = (packedSize(n) + n * n) * sizeof(double);
+
+    printf("Results: threads (T), layout (L), symmetry (S), time in milliseconds of the packing with verification (PV), ");
+    printf("of the packing (P), of the unpacking (U) and of the transpose of the full matrix (FT), bandwidth in GB/s of the packing (PB) and of the unpacking (UB)\n\n");
+    printf("\t|\tT\t|\tL\t|\tS\t|\tPV\t|\tP\t|\tU\t|\tFT\t|\tPB\t|\tUB\t|\n");
+
+    // Executions
+    for (int i = nextThreads(0, threads, true); i != 0; i = nextThreads(i, threads, true)) {  // the sequential and the passed threads
+        omp_set_num_threads(i);
+
+        ts = omp_get_wtime();
+        for (int j = 0; j < rep; j++) matTransposeOMP(M, T, m, n);
+        te = omp_get_wtime();
+        t4 = (te - ts) / rep;
+
+        for (int layout = PACKED_LOWER; layout <= PACKED_RFP; layout++) {
+            ts = omp_get_wtime();
+            for (int j = 0; j < rep; j++) symmetric = packSymmetric(M, P, n, layout, true);
+            te = omp_get_wtime();
+            t1 = (te - ts) / rep;
+
+            ts = omp_get_wtime();
+            for (int j = 0; j < rep; j++) packSymmetric(M, P, n, layout, false);
+            te = omp_get_wtime();
+            t2 = (te - ts) / rep;
+
+            ts = omp_get_wtime();
+            for (int j = 0; j < rep; j++) unpackSymmetric(P, U, n, layout);
+            te = omp_get_wtime();
+            t3 = (te - ts) / rep;
+
+            // Results printing and saving
+            double bandwidth1 = bytes_pack / t2;
+            double bandwidth2 = bytes_unpack / t3;
+
+            printf("\t| %d\t\t| %s\t| %d\t\t| %8.4f\t| %8.4f\t| %8.4f\t| %8.4f\t| %8.4f\t| %8.4f\t|\n", i, layouts[layout], symmetric, t1 * 1e3, t2 * 1e3, t3 * 1e3, t4 * 1e3,
+                   bandwidth1 * 1e-9, bandwidth2 * 1e-9);
+
+            if (saveResultsPacked(CODE, m, n, i, layouts[layout], t1, t2, t3, t4, bandwidth1, bandwidth2) == -1) {
+                printf("Error in saving results!\n\n");
+            }
+        }
+    }
+    // --------------------------------
+
+    printf("\n");
+    for (int layout = PACKED_LOWER; layout <= PACKED_RFP; layout++) {
+        packSymmetric(M, P, n, layout, false);
+        unpackSymmetric(P, U, n, layout);
+        printf("Tested packing (%s): unpacked matrix %s.\n", layouts[layout], isUnpackOf(M, U, P, n, layout) ? "correct" : "incorrect");
+    }
+    testResults(M, T, m, n);
+
+    // Matrices deallocation
+    free(M);
+    free(T);
+    free(P);
+    free(U);
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,274 @@
+#include <immintrin.h>
+#include <math.h>
+#include <omp.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "barrier.h"
+#include "functions.h"
+#include "simd.h"
+
+#define CODE "OBP"
+
+#define BLOCK_SIZE 32
+
+// Trials of the persistent and per call executions, alternated so that drifts of the machine affect both: the time
+// saved per call is the median of the differences of the trials. It can be changed at compile time with
+// -DFORK_JOIN_TRIALS=...
+#ifndef FORK_JOIN_TRIALS
+#define FORK_JOIN_TRIALS 7
+#endif
+
+// Kernels of OB, which open a parallel region at every call
+bool checkSymOMP(const double* M, size_t m, size_t n) {
+    if (m != n) return false;  // only square matrices can be symmetric
+    const size_t size = BLOCK_SIZE < n ? BLOCK_SIZE : n;
+    const size_t blocks = blockCount(n, size);
+    bool check = true;
+
+#pragma omp parallel for reduction(&& : check)
+    for (size_t rb = 0; rb < blocks; rb++) {                 // row blocks indexing
+        for (size_t cb = 0; cb <= rb; cb++) {                // column blocks indexing
+            const double* first = M + (rb * n + cb) * size;  // block matrix of lower triangular part
+            const double* last = M + (cb * n + rb) * size;   // block matrix of higher triangular part
+            check &= checkBlock(first, last, n, blockLength(n, rb, size), blockLength(n, cb, size), rb == cb);
+        }
+    }
+
+    return check;
+}
+
+void matTransposeOMP(const double* M, double* T, size_t m, size_t n) {
+    const size_t size = BLOCK_SIZE < n ? BLOCK_SIZE : n;
+    const size_t row_blocks = blockCount(m, size);
+    const size_t col_blocks = blockCount(n, size);
+
+#pragma omp parallel for collapse(2)
+    for (size_t rb = 0; rb < row_blocks; rb++) {      // row blocks indexing
+        for (size_t cb = 0; cb < col_blocks; cb++) {  // column blocks indexing
+            transposeBlock(M + (rb * n + cb) * size, n, T + (cb * m + rb) * size, m, blockLength(m, rb, size), blockLength(n, cb, size));
+        }
+    }
+}
+
+// Orphaned kernels, called by every thread of an enclosing parallel region: the omp for binds to that region and
+// splits the blocks like the kernels of OB, without its implicit barrier (nowait), which is left to the caller.
+// The threads that find a difference clear *check.
+void checkSymOrphaned(const double* M, size_t m, size_t n, bool* check) {
+    if (m != n) {  // only square matrices can be symmetric
+#pragma omp atomic write
+        *check = false;
+        return;
+    }
+    const size_t size = BLOCK_SIZE < n ? BLOCK_SIZE : n;
+    const size_t blocks = blockCount(n, size);
+    bool c = true;
+
+#pragma omp for nowait
+    for (size_t rb = 0; rb < blocks; rb++) {                 // row blocks indexing
+        for (size_t cb = 0; cb <= rb; cb++) {                // column blocks indexing
+            const double* first = M + (rb * n + cb) * size;  // block matrix of lower triangular part
+            const double* last = M + (cb * n + rb) * size;   // block matrix of higher triangular part
+            c &= checkBlock(first, last, n, blockLength(n, rb, size), blockLength(n, cb, size), rb == cb);
+        }
+    }
+
+    if (!c) {
+#pragma omp atomic write
+        *check = false;
+    }
+}
+
+void matTransposeOrphaned(const double* M, double* T, size_t m, size_t n) {
+    const size_t size = BLOCK_SIZE < n ? BLOCK_SIZE : n;
+    const size_t row_blocks = blockCount(m, size);
+    const size_t col_blocks = blockCount(n, size);
+
+#pragma omp for collapse(2) nowait
+    for (size_t rb = 0; rb < row_blocks; rb++) {      // row blocks indexing
+        for (size_t cb = 0; cb < col_blocks; cb++) {  // column blocks indexing
+            transposeBlock(M + (rb * n + cb) * size, n, T + (cb * m + rb) * size, m, blockLength(m, rb, size), blockLength(n, cb, size));
+        }
+    }
+}
+
+// Runs rep repetitions of the symmetry check inside a single parallel region, separated by a spin barrier.
+// The result of repetition j is written in result[j % 2] while the master resets the other slot, which is not
+// written before the barrier, so that a single barrier per repetition is needed.
+bool checkSymPersistent(const double* M, size_t m, size_t n, int rep) {
+    bool result[2] = {true, true};
+    struct SpinBarrier barrier;
+
+#pragma omp parallel
+    {
+        int sense = 0;
+#pragma omp single
+        initSpinBarrier(&barrier, omp_get_num_threads());
+
+        for (int j = 0; j < rep; j++) {
+#pragma omp master
+            result[(j + 1) % 2] = true;
+            checkSymOrphaned(M, m, n, &result[j % 2]);
+            spinBarrier(&barrier, &sense);
+        }
+    }
+
+    return result[(rep - 1) % 2];
+}
+
+void matTransposePersistent(const double* M, double* T, size_t m, size_t n, int rep) {
+    struct SpinBarrier barrier;
+
+#pragma omp parallel
+    {
+        int sense = 0;
+#pragma omp single
+        initSpinBarrier(&barrier, omp_get_num_threads());
+
+        for (int j = 0; j < rep; j++) {
+            matTransposeOrphaned(M, T, m, n);
+            spinBarrier(&barrier, &sense);
+        }
+    }
+}
+
+static int compareDoubles(const void* a, const void* b) {
+    const double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+// Median of count values, which are sorted
+double median(double* values, int count) {
+    qsort(values, count, sizeof(double), compareDoubles);
+    return count % 2 ? values[count / 2] : (values[count / 2 - 1] + values[count / 2]) / 2;
+}
+
+// The attribute is necessary to avoid the compiler optimization on the repetitions loops
+int __attribute__((optimize("O0"))) main(int argc, char** argv) {
+#ifdef _OPENMP
+    printf("Compiled with OpenMP %d.%02d\n", _OPENMP / 100, _OPENMP % 100);
+#else
+    printf("Error: compile with -fopenmp flag");
+#endif
+
+    size_t m = 0;
+    size_t n = 0;
+    int rep = 0;
+    int threads = 0;
+    if (parseArguments(argc, argv, &m, &n, &rep, &threads) == -1) {
+        return 1;
+    }
+
+    printf("Matrix dimensions: %zu x %zu\n", m, n);
+    printf("Repetitions: %d\n", rep);
+    printf("Trials: %d\n\n", FORK_JOIN_TRIALS);
+
+    // Variables declaration
+    double ts, te, t1, t2, s1 = 0, s2 = 0;  // execution times of the persistent region
+    double f, f1, f2;                       // fork-join time of an empty region and saved by the persistent one, medians
+                                            // of the trials
+    bool symmetric = false;                 // symmetry check
+    double* M;                              // input matrix
+    double* T;                              // transposed matrix
+
+    // Matrices allocation
+    if (initMatrices(&M, &T, m, n) == -1) {
+        printf("Error in allocating matrices!\n\n");
+        return -1;
+    }
+
+    printf("Results: threads (T), symmetry (S), ");
+    printf("symmetry speedup (SS), symmetry efficiency (SE), transpose speedup (TS), transpose efficiency (TE), transpose bandwidth in GB/s (TB), ");
+    printf("fork-join time of an empty parallel region (FJ) and saved per call of symmetry (FS) and transpose (FT) in microseconds\n\n");
+    printf("\t|\tT\t|\tS\t|\tSS\t|\tSE\t|\tTS\t|\tTE\t|\tTB\t|\tFJ\t|\tFS\t|\tFT\t|\n");
+
+    // Executions
+    for (int i = nextThreads(0, threads, true); i != 0; i = nextThreads(i, threads, true)) {  // the sequential and the passed threads
+        omp_set_num_threads(i);
+
+        // Untimed region, so that no trial pays the creation of the threads of the new team
+#pragma omp parallel
+        {
+        }
+
+        double persistent1[FORK_JOIN_TRIALS], persistent2[FORK_JOIN_TRIALS];  // time per call of the persistent region
+        double saved1[FORK_JOIN_TRIALS], saved2[FORK_JOIN_TRIALS];            // time saved per call by it
+        double empty[FORK_JOIN_TRIALS];                                       // time of an empty region
+        for (int k = 0; k < FORK_JOIN_TRIALS; k++) {
+            double calls1 = 0, calls2 = 0;  // time per call with one parallel region per repetition
+            for (int order = 0; order < 2; order++) {  // the first execution alternates between the trials
+                if ((order + k) % 2 == 0) {
+                    // One parallel region for all the repetitions
+                    ts = omp_get_wtime();
+                    symmetric = checkSymPersistent(M, m, n, rep);
+                    te = omp_get_wtime();
+                    persistent1[k] = (te - ts) / rep;
+
+                    ts = omp_get_wtime();
+                    matTransposePersistent(M, T, m, n, rep);
+                    te = omp_get_wtime();
+                    persistent2[k] = (te - ts) / rep;
+                } else {
+                    // One parallel region per repetition, like OB
+                    ts = omp_get_wtime();
+                    for (int j = 0; j < rep; j++) checkSymOMP(M, m, n);
+                    te = omp_get_wtime();
+                    calls1 = (te - ts) / rep;
+
+                    ts = omp_get_wtime();
+                    for (int j = 0; j < rep; j++) matTransposeOMP(M, T, m, n);
+                    te = omp_get_wtime();
+                    calls2 = (te - ts) / rep;
+                }
+            }
+            saved1[k] = calls1 - persistent1[k];
+            saved2[k] = calls2 - persistent2[k];
+
+            // Empty parallel regions
+            ts = omp_get_wtime();
+            for (int j = 0; j < rep; j++) {
+#pragma omp parallel
+                {
+                }
+            }
+            te = omp_get_wtime();
+            empty[k] = (te - ts) / rep;
+        }
+        t1 = median(persistent1, FORK_JOIN_TRIALS);
+        t2 = median(persistent2, FORK_JOIN_TRIALS);
+        f1 = median(saved1, FORK_JOIN_TRIALS);
+        f2 = median(saved2, FORK_JOIN_TRIALS);
+        f = median(empty, FORK_JOIN_TRIALS);
+
+        // Results printing and saving
+        if (i == 1) {
+            s1 = t1;
+            s2 = t2;
+        }
+
+        double speedup1 = (double)s1 / t1;
+        double efficiency1 = (double)speedup1 / i * 100;
+        double speedup2 = (double)s2 / t2;
+        double efficiency2 = (double)speedup2 / i * 100;
+        double bandwidth = 2 * m * n * sizeof(double) / (t2);
+
+        printf("\t| %d\t\t| %d\t\t| %8.4f\t| %8.4f\t| %8.4f\t| %8.4f\t| %8.4f\t| %8.3f\t| %8.3f\t| %8.3f\t|\n", i, symmetric, speedup1, efficiency1, speedup2, efficiency2, bandwidth * 1e-9,
+               f * 1e6, f1 * 1e6, f2 * 1e6);
+
+        if (saveResultsOMP(CODE, m, n, i, speedup1, efficiency1, speedup2, efficiency2, bandwidth) == -1 || saveResultsForkJoin(CODE, m, n, i, f, f1, f2) == -1) {
+            printf("Error in saving results!\n\n");
+        }
+    }
+    // --------------------------------
+
+    printf("\n");
+    testResults(M, T, m, n);
+
+    // Matrices deallocation
+    free(M);
+    free(T);
+
+    return 0;
+}
\ No newline at end of file
@@ -10,14 +10,15 @@
 
 #define CODE "OR"
 
-bool checkSymOMP(const double* M, int n) {
+bool checkSymOMP(const double* M, size_t m, size_t n) {
+    if (m != n) return false;  // only square matrices can be symmetric
     bool check = true;
 
 #pragma omp parallel reduction(&& : check)
     {
         bool c = true;
-        for (int i = 1; i < n; i++) {
-            for (int j = 0; j < i; j++) {
+        for (size_t i = 1; i < n; i++) {
+            for (size_t j = 0; j < i; j++) {
                 if (fabs(M[i * n + j] - M[j * n + i]) > EPSILON) {
                     c = false;
                 }
@@ -29,11 +30,11 @@ bool checkSymOMP(const double* M, int n) {
     return check;
 }
 
-void matTransposeOMP(const double* M, double* T, int n) {
+void matTransposeOMP(const double* M, double* T, size_t m, size_t n) {
 #pragma omp parallel for collapse(2)
-    for (int i = 0; i < n; i++) {
-        for (int j = 0; j < n; j++) {
-            T[j * n + i] = M[i * n + j];
+    for (size_t i = 0; i < m; i++) {
+        for (size_t j = 0; j < n; j++) {
+            T[j * m + i] = M[i * n + j];
         }
     }
 }
@@ -46,28 +47,15 @@ int __attribute__((optimize("O0"))) main(int argc, char** argv) {
     printf("Error: compile with -fopenmp flag");
 #endif
 
-    int dim = 0;
+    size_t m = 0;
+    size_t n = 0;
     int rep = 0;
     int threads = 0;
-    if (argc < 2) {
-        printf("Correct usage: program-name [M dimension as exponent of 2] [number of repetitions (default 5)] [number of threads (0 to run all cases)]\n\n");
+    if (parseArguments(argc, argv, &m, &n, &rep, &threads) == -1) {
         return 1;
-    } else if (argc == 2) {
-        dim = atoi(argv[1]);
-        rep = 500;
-        threads = 0;
-    } else if (argc == 3) {
-        dim = atoi(argv[1]);
-        rep = atoi(argv[2]) > 0 ? atoi(argv[2]) : 500;
-        threads = 0;
-    } else {
-        dim = atoi(argv[1]);
-        rep = atoi(argv[2]) > 0 ? atoi(argv[2]) : 500;
-        threads = atoi(argv[3]) >= 0 ? atoi(argv[3]) : 0;
     }
 
-    unsigned int n = pow(2, dim);
-    printf("Matrix dimension: %d\n", n);
+    printf("Matrix dimensions: %zu x %zu\n", m, n);
     printf("Repetitions: %d\n\n", rep);
 
     // Variables declaration
@@ -77,7 +65,7 @@ int __attribute__((optimize("O0"))) main(int argc, char** argv) {
     double* T;                                  // transposed matrix
 
     // Matrices allocation
-    if (initMatrices(&M, &T, n) == -1) {
+    if (initMatrices(&M, &T, m, n) == -1) {
         printf("Error in allocating matrices!\n\n");
         return -1;
     }
@@ -85,11 +73,11 @@ int __attribute__((optimize("O0"))) main(int argc, char** argv) {
     omp_set_num_threads(1);
 
     ts1 = omp_get_wtime();
-    for (int i = 0; i < rep; i++) symmetric = checkSymOMP(M, n);
+    for (int i = 0; i < rep; i++) symmetric = checkSymOMP(M, m, n);
     te1 = omp_get_wtime();
 
     ts2 = omp_get_wtime();
-    for (int i = 0; i < rep; i++) matTransposeOMP(M, T, n);
+    for (int i = 0; i < rep; i++) matTransposeOMP(M, T, m, n);
     te2 = omp_get_wtime();
 
     s1 = (te1 - ts1) / rep;
@@ -103,8 +91,8 @@ int __attribute__((optimize("O0"))) main(int argc, char** argv) {
     printf("symmetry speedup (SS), symmetry efficiency (SE), transpose speedup (TS), transpose efficiency (TE), transpose bandwidth in GB/s (TB) \n\n");
     printf("\t|\tT\t|\tS\t|\tSS\t|\tSE\t|\tTS\t|\tTE\t|\tTB\t|\n");
     
-    double bandwidth = 2 * n * n * sizeof(double) / (s2);
-    if (saveResultsOMP(CODE, n, 1, 1, 100, 1, 100, bandwidth) == -1) {
+    double bandwidth = 2 * m * n * sizeof(double) / (s2);
+    if (saveResultsOMP(CODE, m, n, 1, 1, 100, 1, 100, bandwidth) == -1) {
         printf("Error in saving results!\n\n");
     }
 
@@ -114,11 +102,11 @@ int __attribute__((optimize("O0"))) main(int argc, char** argv) {
             omp_set_num_threads(i);
 
             ts1 = omp_get_wtime();
-            for (int j = 0; j < rep; j++) symmetric = checkSymOMP(M, n);
+            for (int j = 0; j < rep; j++) symmetric = checkSymOMP(M, m, n);
             te1 = omp_get_wtime();
 
             ts2 = omp_get_wtime();
-            for (int j = 0; j < rep; j++) matTransposeOMP(M, T, n);
+            for (int j = 0; j < rep; j++) matTransposeOMP(M, T, m, n);
             te2 = omp_get_wtime();
 
             // Results printing and saving
@@ -129,22 +117,22 @@ int __attribute__((optimize("O0"))) main(int argc, char** argv) {
             double efficiency1 = (double)speedup1 / i * 100;
             double speedup2 = (double)s2 / t2;
             double efficiency2 = (double)speedup2 / i * 100;
-            double bandwidth = 2 * n * n * sizeof(double) / (t2);
+            double bandwidth = 2 * m * n * sizeof(double) / (t2);
 
             printf("\t| %d\t\t| %d\t\t| %8.4f\t| %8.4f\t| %8.4f\t| %8.4f\t| %8.4f\t|\n", i, symmetric, speedup1, efficiency1, speedup2, efficiency2, bandwidth * 1e-9);
 
-            if (saveResultsOMP(CODE, n, i, speedup1, efficiency1, speedup2, efficiency2, bandwidth) == -1) {
+            if (saveResultsOMP(CODE, m, n, i, speedup1, efficiency1, speedup2, efficiency2, bandwidth) == -1) {
                 printf("Error in saving results!\n\n");
             }
         }
     } else {
         omp_set_num_threads(threads);
         ts1 = omp_get_wtime();
-        for (int j = 0; j < rep; j++) symmetric = checkSymOMP(M, n);
+        for (int j = 0; j < rep; j++) symmetric = checkSymOMP(M, m, n);
         te1 = omp_get_wtime();
 
         ts2 = omp_get_wtime();
-        for (int j = 0; j < rep; j++) matTransposeOMP(M, T, n);
+        for (int j = 0; j < rep; j++) matTransposeOMP(M, T, m, n);
         te2 = omp_get_wtime();
 
         // Results printing and saving
@@ -155,18 +143,18 @@ int __attribute__((optimize("O0"))) main(int argc, char** argv) {
         double efficiency1 = (double)speedup1 / threads * 100;
         double speedup2 = (double)s2 / t2;
         double efficiency2 = (double)speedup2 / threads * 100;
-        double bandwidth = 2 * n * n * sizeof(double) / (t2);
+        double bandwidth = 2 * m * n * sizeof(double) / (t2);
 
         printf("\t| %d\t\t| %d\t\t| %8.4f\t| %8.4f\t| %8.4f\t| %8.4f\t| %8.4f\t|\n", threads, symmetric, speedup1, efficiency1, speedup2, efficiency2, bandwidth);
 
-        if (saveResultsOMP(CODE, n, threads, speedup1, efficiency1, speedup2, efficiency2, bandwidth) == -1) {
+        if (saveResultsOMP(CODE, m, n, threads, speedup1, efficiency1, speedup2, efficiency2, bandwidth) == -1) {
             printf("Error in saving results!\n\n");
         }
     }
     // --------------------------------
 
     printf("\n");
-    testResults(M, T, n);
+    testResults(M, T, m, n);
 
     // Matrices deallocation
     free(M);
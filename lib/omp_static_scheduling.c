@@ -12,8 +12,10 @@
 
 #define BLOCK_SIZE 32
 
-bool checkSymOMP(const double* M, int n) {
-    const int size = BLOCK_SIZE < n ? BLOCK_SIZE : n / omp_get_num_threads();
+bool checkSymOMP(const double* M, size_t m, size_t n) {
+    if (m != n) return false;  // only square matrices can be symmetric
+    const size_t size = BLOCK_SIZE < n ? BLOCK_SIZE : n / omp_get_num_threads();
+    const size_t blocks = blockCount(n, size);
     bool check = true;
 
 #pragma omp parallel reduction(&& : check)
@@ -25,12 +27,14 @@ bool checkSymOMP(const double* M, int n) {
 #pragma omp allocate(first, last, c) allocator(omp_thread_mem_alloc)
 
 #pragma omp for schedule(static, 1)
-        for (int rb = 0; rb < n / size; rb++) {    // row blocks indexing
-            for (int cb = 0; cb <= rb; cb++) {     // column blocks indexing
+        for (size_t rb = 0; rb < blocks; rb++) {   // row blocks indexing
+            for (size_t cb = 0; cb <= rb; cb++) {  // column blocks indexing
                 first = M + (rb * n + cb) * size;  // block matrix of lower triangular part
                 last = M + (cb * n + rb) * size;   // block matrix of higher triangular part
-                for (int i = 0; i < size; i++) {   // symmetry check
-                    for (int j = 0; j < size; j++) {
+                const size_t rows = blockLength(n, rb, size);  // edge blocks can be smaller
+                const size_t cols = blockLength(n, cb, size);
+                for (size_t i = 0; i < rows; i++) {  // symmetry check
+                    for (size_t j = 0; j < cols; j++) {
                         if (fabs(first[i * n + j] - last[j * n + i]) > EPSILON) {
                             c = false;
                         }
@@ -45,8 +49,10 @@ bool checkSymOMP(const double* M, int n) {
     return check;
 }
 
-void matTransposeOMP(const double* M, double* T, int n) {
-    const int size = BLOCK_SIZE < n ? BLOCK_SIZE : n / omp_get_num_threads();
+void matTransposeOMP(const double* M, double* T, size_t m, size_t n) {
+    const size_t size = BLOCK_SIZE < n ? BLOCK_SIZE : n / omp_get_num_threads();
+    const size_t row_blocks = blockCount(m, size);
+    const size_t col_blocks = blockCount(n, size);
 #pragma omp parallel
     {
         const double* source;
@@ -54,13 +60,15 @@ void matTransposeOMP(const double* M, double* T, int n) {
 #pragma omp allocate(source, destination) allocator(omp_thread_mem_alloc)
 
 #pragma omp for collapse(2) schedule(static, 1)
-        for (int rb = 0; rb < n / size; rb++) {          // row blocks indexing
-            for (int cb = 0; cb < n / size; cb++) {      // column blocks indexing
+        for (size_t rb = 0; rb < row_blocks; rb++) {     // row blocks indexing
+            for (size_t cb = 0; cb < col_blocks; cb++) { // column blocks indexing
                 source = M + (rb * n + cb) * size;       // block matrix of lower triangular part
-                destination = T + (cb * n + rb) * size;  // block matrix of higher triangular part
-                for (int i = 0; i < size; i++) {         // transposing
-                    for (int j = 0; j < size; j++) {
-                        destination[j * n + i] = source[i * n + j];
+                destination = T + (cb * m + rb) * size;  // block matrix of higher triangular part
+                const size_t rows = blockLength(m, rb, size);  // edge blocks can be smaller
+                const size_t cols = blockLength(n, cb, size);
+                for (size_t i = 0; i < rows; i++) {      // transposing
+                    for (size_t j = 0; j < cols; j++) {
+                        destination[j * m + i] = source[i * n + j];
                     }
                 }
             }
@@ -76,28 +84,15 @@ int __attribute__((optimize("O0"))) main(int argc, char** argv) {
     printf("Error: compile with -fopenmp flag");
 #endif
 
-    int dim = 0;
+    size_t m = 0;
+    size_t n = 0;
     int rep = 0;
     int threads = 0;
-    if (argc < 2) {
-        printf("Correct usage: program-name [M dimension as exponent of 2] [number of repetitions (default 5)] [number of threads (0 to run all cases)]\n\n");
+    if (parseArguments(argc, argv, &m, &n, &rep, &threads) == -1) {
         return 1;
-    } else if (argc == 2) {
-        dim = atoi(argv[1]);
-        rep = 500;
-        threads = 0;
-    } else if (argc == 3) {
-        dim = atoi(argv[1]);
-        rep = atoi(argv[2]) > 0 ? atoi(argv[2]) : 500;
-        threads = 0;
-    } else {
-        dim = atoi(argv[1]);
-        rep = atoi(argv[2]) > 0 ? atoi(argv[2]) : 500;
-        threads = atoi(argv[3]) >= 0 ? atoi(argv[3]) : 0;
     }
 
-    unsigned int n = pow(2, dim);
-    printf("Matrix dimension: %d\n", n);
+    printf("Matrix dimensions: %zu x %zu\n", m, n);
     printf("Repetitions: %d\n\n", rep);
 
     // Variables declaration
@@ -107,7 +102,7 @@ int __attribute__((optimize("O0"))) main(int argc, char** argv) {
     double* T;                                  // transposed matrix
 
     // Matrices allocation
-    if (initMatrices(&M, &T, n) == -1) {
+    if (initMatrices(&M, &T, m, n) == -1) {
         printf("Error in allocating matrices!\n\n");
         return -1;
     }
@@ -115,11 +110,11 @@ int __attribute__((optimize("O0"))) main(int argc, char** argv) {
     omp_set_num_threads(1);
 
     ts1 = omp_get_wtime();
-    for (int i = 0; i < rep; i++) symmetric = checkSymOMP(M, n);
+    for (int i = 0; i < rep; i++) symmetric = checkSymOMP(M, m, n);
     te1 = omp_get_wtime();
 
     ts2 = omp_get_wtime();
-    for (int i = 0; i < rep; i++) matTransposeOMP(M, T, n);
+    for (int i = 0; i < rep; i++) matTransposeOMP(M, T, m, n);
     te2 = omp_get_wtime();
 
     s1 = (te1 - ts1) / rep;
@@ -133,8 +128,8 @@ int __attribute__((optimize("O0"))) main(int argc, char** argv) {
     printf("symmetry speedup (SS), symmetry efficiency (SE), transpose speedup (TS), transpose efficiency (TE), transpose bandwidth in GB/s (TB) \n\n");
     printf("\t|\tT\t|\tS\t|\tSS\t|\tSE\t|\tTS\t|\tTE\t|\tTB\t|\n");
     
-    double bandwidth = 2 * n * n * sizeof(double) / (s2);
-    if (saveResultsOMP(CODE, n, 1, 1, 100, 1, 100, bandwidth) == -1) {
+    double bandwidth = 2 * m * n * sizeof(double) / (s2);
+    if (saveResultsOMP(CODE, m, n, 1, 1, 100, 1, 100, bandwidth) == -1) {
         printf("Error in saving results!\n\n");
     }
 
@@ -144,11 +139,11 @@ int __attribute__((optimize("O0"))) main(int argc, char** argv) {
             omp_set_num_threads(i);
 
             ts1 = omp_get_wtime();
-            for (int j = 0; j < rep; j++) symmetric = checkSymOMP(M, n);
+            for (int j = 0; j < rep; j++) symmetric = checkSymOMP(M, m, n);
             te1 = omp_get_wtime();
 
             ts2 = omp_get_wtime();
-            for (int j = 0; j < rep; j++) matTransposeOMP(M, T, n);
+            for (int j = 0; j < rep; j++) matTransposeOMP(M, T, m, n);
             te2 = omp_get_wtime();
 
             // Results printing and saving
@@ -159,22 +154,22 @@ int __attribute__((optimize("O0"))) main(int argc, char** argv) {
             double efficiency1 = (double)speedup1 / i * 100;
             double speedup2 = (double)s2 / t2;
             double efficiency2 = (double)speedup2 / i * 100;
-            double bandwidth = 2 * n * n * sizeof(double) / (t2);
+            double bandwidth = 2 * m * n * sizeof(double) / (t2);
 
             printf("\t| %d\t\t| %d\t\t| %8.4f\t| %8.4f\t| %8.4f\t| %8.4f\t| %8.4f\t|\n", i, symmetric, speedup1, efficiency1, speedup2, efficiency2, bandwidth * 1e-9);
 
-            if (saveResultsOMP(CODE, n, i, speedup1, efficiency1, speedup2, efficiency2, bandwidth) == -1) {
+            if (saveResultsOMP(CODE, m, n, i, speedup1, efficiency1, speedup2, efficiency2, bandwidth) == -1) {
                 printf("Error in saving results!\n\n");
             }
         }
     } else {
         omp_set_num_threads(threads);
         ts1 = omp_get_wtime();
-        for (int j = 0; j < rep; j++) symmetric = checkSymOMP(M, n);
+        for (int j = 0; j < rep; j++) symmetric = checkSymOMP(M, m, n);
         te1 = omp_get_wtime();
 
         ts2 = omp_get_wtime();
-        for (int j = 0; j < rep; j++) matTransposeOMP(M, T, n);
+        for (int j = 0; j < rep; j++) matTransposeOMP(M, T, m, n);
         te2 = omp_get_wtime();
 
         // Results printing and saving
@@ -185,18 +180,18 @@ int __attribute__((optimize("O0"))) main(int argc, char** argv) {
         double efficiency1 = (double)speedup1 / threads * 100;
         double speedup2 = (double)s2 / t2;
         double efficiency2 = (double)speedup2 / threads * 100;
-        double bandwidth = 2 * n * n * sizeof(double) / (t2);
+        double bandwidth = 2 * m * n * sizeof(double) / (t2);
 
         printf("\t| %d\t\t| %d\t\t| %8.4f\t| %8.4f\t| %8.4f\t| %8.4f\t| %8.4f\t|\n", threads, symmetric, speedup1, efficiency1, speedup2, efficiency2, bandwidth);
 
-        if (saveResultsOMP(CODE, n, threads, speedup1, efficiency1, speedup2, efficiency2, bandwidth) == -1) {
+        if (saveResultsOMP(CODE, m, n, threads, speedup1, efficiency1, speedup2, efficiency2, bandwidth) == -1) {
             printf("Error in saving results!\n\n");
         }
     }
     // --------------------------------
 
     printf("\n");
-    testResults(M, T, n);
+    testResults(M, T, m, n);
 
     // Matrices deallocation
     free(M);
@@ -0,0 +1,329 @@
+#include <errno.h>
+#include <fcntl.h>
+#include <immintrin.h>
+#include <math.h>
+#include <omp.h>
+#include <signal.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "barrier.h"
+#include "functions.h"
+#include "simd.h"
+
+#define CODE "OST"
+
+#define BLOCK_SIZE 32
+
+// Buffers of the ring shared by the stages: one is read while one is computed and one is written. It can be changed
+// at compile time with -DSTREAM_BUFFERS=...
+#ifndef STREAM_BUFFERS
+#define STREAM_BUFFERS 3
+#endif
+
+// Threads of the pipeline: the reader, the compute stage, the writer and the producer
+#define STREAM_STAGES 4
+
+// A buffer of the ring: the matrix of a frame, its transpose and the result of its symmetry check
+struct Slot {
+    double* M;
+    double* T;
+    size_t m;
+    size_t n;
+    bool symmetric;
+};
+
+// Ring of preallocated buffers: frame f is in slots[f % STREAM_BUFFERS]. Every stage owns the frames between its
+// counter and the counter of the previous stage, so the counters are the only shared state; the frames are published
+// by incrementing the counters with release stores and acquired by the next stage.
+struct Ring {
+    struct Slot slots[STREAM_BUFFERS];
+    atomic_size_t read;      // frames read from the stream
+    atomic_size_t computed;  // frames checked and transposed
+    atomic_size_t written;   // frames written downstream, whose slots can be reused
+    atomic_int read_end;     // the reader found the end of the stream (or an invalid frame)
+    atomic_int compute_end;  // the compute stage processed the last frame
+};
+
+// Reads bytes from the stream, repeating the partial reads of pipes. Returns the bytes read, fewer at the end of the
+// stream, or -1 on error
+ssize_t readStream(int fd, void* buffer, size_t bytes) {
+    size_t total = 0;
+    while (total < bytes) {
+        ssize_t done = read(fd, (char*)buffer + total, bytes - total);
+        if (done == -1 && errno == EINTR) continue;
+        if (done == -1) return -1;
+        if (done == 0) break;
+        total += done;
+    }
+    return total;
+}
+
+int writeStream(int fd, const void* buffer, size_t bytes) {
+    while (bytes > 0) {
+        ssize_t done = write(fd, buffer, bytes);
+        if (done == -1 && errno == EINTR) continue;
+        if (done <= 0) return -1;
+        buffer = (const char*)buffer + done;
+        bytes -= done;
+    }
+    return 0;
+}
+
+// A frame is a matrix file (header, padding up to the offset and payload) of row-major doubles, so that matrix files
+// can be streamed as they are, e.g. with cat. Writes M (m x n) as a frame
+int writeFrame(int fd, const double* M, size_t m, size_t n) {
+    struct MatrixHeader header = {MATRIX_FILE_MAGIC, MATRIX_FILE_VERSION, MATRIX_F64, MATRIX_ROW_MAJOR, sizeof(double), m, n, n, MATRIX_FILE_ALIGNMENT, 0};
+    static const char padding[MATRIX_FILE_ALIGNMENT] = {0};
+
+    if (writeStream(fd, &header, sizeof(header)) == -1 || writeStream(fd, padding, header.offset - sizeof(header)) == -1) return -1;
+    return writeStream(fd, M, m * n * sizeof(double));
+}
+
+// Reads the next frame into the slot, whose matrices hold capacity doubles. Returns 1 if a frame was read, 0 at the end
+// of the stream and -1 on an invalid or truncated frame
+int readFrame(int fd, struct Slot* slot, size_t capacity) {
+    struct MatrixHeader header;
+    char padding[512];
+
+    ssize_t bytes = readStream(fd, &header, sizeof(header));
+    if (bytes == 0) return 0;
+    if (bytes != sizeof(header) || !validMatrixHeader(&header)) return -1;
+    if (header.type != MATRIX_F64 || header.layout != MATRIX_ROW_MAJOR || header.ld != header.cols || header.rows * header.cols > capacity) return -1;
+
+    for (size_t skip = header.offset - sizeof(header); skip > 0;) {  // padding before the payload
+        const size_t length = skip < sizeof(padding) ? skip : sizeof(padding);
+        if (readStream(fd, padding, length) != (ssize_t)length) return -1;
+        skip -= length;
+    }
+
+    slot->m = header.rows;
+    slot->n = header.cols;
+    bytes = readStream(fd, slot->M, slot->m * slot->n * sizeof(double));
+
+    return bytes == (ssize_t)(slot->m * slot->n * sizeof(double)) ? 1 : -1;
+}
+
+// Waits until the counter is greater than value, adding the waited time to stall. Returns false if the previous stage
+// ended (end is set) without reaching it. The waiting thread yields the core after SPIN_LIMIT spins, as the stages
+// share the cores with the compute team.
+bool waitFor(atomic_size_t* counter, size_t value, atomic_int* end, double* stall) {
+    const double start = omp_get_wtime();
+    bool reached = true;
+
+    for (int spins = 0; atomic_load_explicit(counter, memory_order_acquire) <= value; spins++) {
+        // the counter is incremented before the end is set, so it is read again after it
+        if (end != NULL && atomic_load_explicit(end, memory_order_acquire) && atomic_load_explicit(counter, memory_order_acquire) <= value) {
+            reached = false;
+            break;
+        }
+        if (spins < SPIN_LIMIT) _mm_pause();
+        else sched_yield();
+    }
+
+    *stall += omp_get_wtime() - start;
+    return reached;
+}
+
+void matTransposeOMP(const double* M, double* T, size_t m, size_t n) {
+    const size_t size = BLOCK_SIZE < n ? BLOCK_SIZE : n;
+    const size_t row_blocks = blockCount(m, size);
+    const size_t col_blocks = blockCount(n, size);
+
+#pragma omp parallel for collapse(2)
+    for (size_t rb = 0; rb < row_blocks; rb++) {      // row blocks indexing
+        for (size_t cb = 0; cb < col_blocks; cb++) {  // column blocks indexing
+            transposeBlock(M + (rb * n + cb) * size, n, T + (cb * m + rb) * size, m, blockLength(m, rb, size), blockLength(n, cb, size));
+        }
+    }
+}
+
+// Fused kernel of OF: every pair of blocks is read once, checked and written transposed in T
+bool checkSymTransposeOMP(const double* M, double* T, size_t m, size_t n) {
+    if (m != n) {
+        matTransposeOMP(M, T, m, n);
+        return false;
+    }
+    const size_t size = BLOCK_SIZE < n ? BLOCK_SIZE : n;
+    const size_t blocks = blockCount(n, size);
+    bool check = true;
+
+#pragma omp parallel for schedule(dynamic, 1) reduction(&& : check)
+    for (size_t rb = 0; rb < blocks; rb++) {      // row blocks indexing
+        for (size_t cb = 0; cb <= rb; cb++) {     // column blocks indexing
+            const size_t first = (rb * n + cb) * size;  // offset of the block of lower triangular part
+            const size_t last = (cb * n + rb) * size;   // offset of the block of higher triangular part
+            check &= checkTransposeBlock(M + first, M + last, T + first, T + last, n, blockLength(n, rb, size), blockLength(n, cb, size), rb == cb);
+        }
+    }
+
+    return check;
+}
+
+// The attribute is necessary to avoid the compiler optimization on the repetitions loops
+int __attribute__((optimize("O0"))) main(int argc, char** argv) {
+#ifdef _OPENMP
+    printf("Compiled with OpenMP %d.%02d\n", _OPENMP / 100, _OPENMP % 100);
+#else
+    printf("Error: compile with -fopenmp flag");
+#endif
+
+    size_t m = 0;
+    size_t n = 0;
+    int rep = 0;
+    int threads = 0;
+    if (parseArguments(argc, argv, &m, &n, &rep, &threads) == -1) {
+        return 1;
+    }
+    if (inputFile != NULL) {  // a named pipe would lose the header read by parseArguments
+        printf("Error: the stream is read from the standard input, redirect it with < FILE\n\n");
+        return 1;
+    }
+    if (threads == 0) threads = omp_get_num_procs();  // all the cores by default
+
+    // Without a stream on the standard input (a terminal or /dev/null), a producer generates rep workload matrices
+    struct stat input;
+    const bool produce = fstat(STDIN_FILENO, &input) == -1 || !(S_ISFIFO(input.st_mode) || S_ISREG(input.st_mode) || S_ISSOCK(input.st_mode));
+    const char* output = outputFile;
+    outputFile = NULL;  // T is written by the writer stage, not by testResults
+
+    printf("Maximum matrix dimensions: %zu x %zu\n", m, n);
+    printf("Input: %s\n", produce ? "generated" : "standard input");
+    printf("Output: %s\n", output != NULL ? output : "none");
+    printf("Threads: %d\n", threads);
+    printf("Buffers: %d\n\n", STREAM_BUFFERS);
+
+    // Variables declaration
+    double ts, te;                                 // execution time of the pipeline
+    double compute = 0;                            // time of the compute stage on the frames
+    double read_stall = 0;                         // time of the reader waiting for a free buffer
+    double compute_stall = 0;                      // time of the compute stage waiting for a frame
+    double write_stall = 0;                        // time of the writer waiting for a computed frame
+    size_t symmetric = 0;                          // symmetric matrices of the stream
+    size_t bytes = 0;                              // bytes of the matrices of the stream
+    bool read_error = false;                       // invalid or truncated frame
+    bool write_error = false;                      // failed write downstream
+    bool understaffed = false;                     // team without a thread per stage
+    int in = STDIN_FILENO;                         // read end of the stream
+    int out = -1;                                  // downstream file or named pipe
+    int pipes[2] = {-1, -1};                       // pipe fed by the producer
+    static struct Ring ring;                       // buffers shared by the stages
+    double* G = NULL;                              // generated matrix of the producer
+
+    // Buffers allocation, the ring is filled before the stream starts
+    for (int s = 0; s < STREAM_BUFFERS; s++) {
+        if ((ring.slots[s].M = allocMatrix(m, n)) == NULL || (ring.slots[s].T = allocMatrix(m, n)) == NULL) {
+            printf("Error in allocating matrices!\n\n");
+            return -1;
+        }
+    }
+    if (produce && (pipe(pipes) == -1 || initMatrix(&G, m, n) == -1)) {
+        printf("Error in creating the producer!\n\n");
+        return -1;
+    }
+    if (produce) in = pipes[0];
+    signal(SIGPIPE, SIG_IGN);  // a closed pipe fails the writes instead of terminating the program
+    if (output != NULL && (out = open(output, O_WRONLY | O_CREAT | O_TRUNC, 0644)) == -1) {
+        printf("Error in opening %s!\n\n", output);
+        return -1;
+    }
+
+    // Pipeline: the reader, the compute stage (with a nested team of threads) and the writer run concurrently on
+    // the frames of the ring, and the producer feeds the pipe when the stream is generated
+    // the stages wait for each other, so they need a thread each: the team is not reduced dynamically, and a smaller one
+    // (e.g. with OMP_THREAD_LIMIT) runs no stage
+    omp_set_max_active_levels(2);
+    omp_set_dynamic(0);
+    ts = omp_get_wtime();
+#pragma omp parallel num_threads(STREAM_STAGES)
+    {
+        const int stage = omp_get_num_threads() == STREAM_STAGES ? omp_get_thread_num() : -1;
+        if (stage == -1 && omp_get_thread_num() == 0) understaffed = true;
+
+        if (stage == 0) {  // reader
+            for (size_t f = 0;; f++) {
+                // the slot of frame f is free when frame f - STREAM_BUFFERS has been written
+                if (f >= STREAM_BUFFERS) waitFor(&ring.written, f - STREAM_BUFFERS, NULL, &read_stall);
+                int result = readFrame(in, &ring.slots[f % STREAM_BUFFERS], m * n);
+                if (result != 1) {
+                    read_error = result == -1;
+                    break;
+                }
+                atomic_store_explicit(&ring.read, f + 1, memory_order_release);
+            }
+            atomic_store_explicit(&ring.read_end, 1, memory_order_release);
+            if (produce) close(pipes[0]);  // stops a producer still writing
+        } else if (stage == 1) {  // compute stage
+            omp_set_num_threads(threads);
+            for (size_t f = 0; waitFor(&ring.read, f, &ring.read_end, &compute_stall); f++) {
+                struct Slot* slot = &ring.slots[f % STREAM_BUFFERS];
+                const double start = omp_get_wtime();
+                slot->symmetric = checkSymTransposeOMP(slot->M, slot->T, slot->m, slot->n);
+                compute += omp_get_wtime() - start;
+                atomic_store_explicit(&ring.computed, f + 1, memory_order_release);
+            }
+            atomic_store_explicit(&ring.compute_end, 1, memory_order_release);
+        } else if (stage == 2) {  // writer
+            for (size_t f = 0; waitFor(&ring.computed, f, &ring.compute_end, &write_stall); f++) {
+                const struct Slot* slot = &ring.slots[f % STREAM_BUFFERS];
+                if (out != -1 && !write_error && writeFrame(out, slot->T, slot->n, slot->m) == -1) write_error = true;
+                symmetric += slot->symmetric;
+                bytes += slot->m * slot->n * sizeof(double);
+                atomic_store_explicit(&ring.written, f + 1, memory_order_release);
+            }
+        } else if (stage == 3) {  // producer
+            if (produce) {
+                for (int j = 0; j < rep && writeFrame(pipes[1], G, m, n) == 0; j++);
+                close(pipes[1]);  // end of the stream
+            }
+        }
+    }
+    te = omp_get_wtime();
+    // --------------------------------
+
+    if (understaffed) {
+        printf("Error: the pipeline needs %d threads running at the same time, check OMP_THREAD_LIMIT!\n\n", STREAM_STAGES);
+        return 1;
+    }
+
+    // Results printing and saving: throughput of the whole pipeline, the stall times show the stage that limits it
+    const size_t matrices = atomic_load(&ring.written);
+    const double time = te - ts;
+    double throughput = matrices / time;
+    double bandwidth = bytes / time;
+
+    if (read_error) printf("Error: invalid frame in the stream, the pipeline stopped after %zu matrices!\n\n", matrices);
+    if (write_error) printf("Error in writing the transposed matrices to %s!\n\n", output);
+    printf("Results: matrices (N), symmetric matrices (S), matrices per second (MPS), bandwidth of the stream in GB/s (B), time in milliseconds ");
+    printf("of the compute stage (C) and of the stalls of the reader waiting for a free buffer (RS), of the compute stage waiting for a frame (CS) ");
+    printf("and of the writer waiting for a computed frame (WS)\n\n");
+    printf("\t|\tN\t|\tS\t|\tMPS\t|\tB\t|\tC\t|\tRS\t|\tCS\t|\tWS\t|\n");
+    printf("\t| %zu\t\t| %zu\t\t| %8.2f\t| %8.4f\t| %8.2f\t| %8.2f\t| %8.2f\t| %8.2f\t|\n", matrices, symmetric, throughput, bandwidth * 1e-9, compute * 1e3,
+           read_stall * 1e3, compute_stall * 1e3, write_stall * 1e3);
+
+    if (saveResultsStreaming(CODE, m, n, threads, STREAM_BUFFERS, matrices, time, throughput, bandwidth, read_stall, compute_stall, write_stall) == -1) {
+        printf("Error in saving results!\n\n");
+    }
+
+    // The last frame is still in its buffer
+    printf("\n");
+    if (matrices > 0) {
+        const struct Slot* last = &ring.slots[(matrices - 1) % STREAM_BUFFERS];
+        testResults(last->M, last->T, last->m, last->n);
+    }
+
+    // Buffers deallocation
+    if (out != -1) close(out);
+    for (int s = 0; s < STREAM_BUFFERS; s++) {
+        free(ring.slots[s].M);
+        free(ring.slots[s].T);
+    }
+    free(G);
+
+    return 0;
+}
\ No newline at end of file
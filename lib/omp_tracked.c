@@ -0,0 +1,217 @@
+#include <immintrin.h>
+#include <math.h>
+#include <omp.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "functions.h"
+#include "tracked.h"
+
+#define CODE "OTR"
+
+#define BLOCK_SIZE 32
+
+// Symmetric pairs of elements written between two queries. It can be changed at compile time with -DTRACKED_UPDATES=...
+#ifndef TRACKED_UPDATES
+#define TRACKED_UPDATES 64
+#endif
+
+// Largest number of pairs of elements written between two refreshes of the transpose, the densities are the powers of
+// 4 up to it. It can be changed at compile time with -DTRACKED_DENSITY_MAX=...
+#ifndef TRACKED_DENSITY_MAX
+#define TRACKED_DENSITY_MAX 16384
+#endif
+
+// Full symmetry check of OB_D, the cost of a query without tracking
+bool checkSymOMP(const double* M, size_t m, size_t n) {
+    if (m != n) return false;  // only square matrices can be symmetric
+    const size_t size = BLOCK_SIZE < n ? BLOCK_SIZE : n;
+    const size_t blocks = blockCount(n, size);
+    bool check = true;
+
+#pragma omp parallel for schedule(dynamic, 1) reduction(&& : check)
+    for (size_t rb = 0; rb < blocks; rb++) {                 // row blocks indexing
+        for (size_t cb = 0; cb <= rb; cb++) {                // column blocks indexing
+            const double* first = M + (rb * n + cb) * size;  // block matrix of lower triangular part
+            const double* last = M + (cb * n + rb) * size;   // block matrix of higher triangular part
+            check &= checkBlock(first, last, n, blockLength(n, rb, size), blockLength(n, cb, size), rb == cb);
+        }
+    }
+
+    return check;
+}
+
+void matTransposeOMP(const double* M, double* T, size_t m, size_t n) {
+    const size_t size = BLOCK_SIZE < n ? BLOCK_SIZE : n;
+    const size_t row_blocks = blockCount(m, size);
+    const size_t col_blocks = blockCount(n, size);
+
+#pragma omp parallel for collapse(2)
+    for (size_t rb = 0; rb < row_blocks; rb++) {      // row blocks indexing
+        for (size_t cb = 0; cb < col_blocks; cb++) {  // column blocks indexing
+            transposeBlock(M + (rb * n + cb) * size, n, T + (cb * m + rb) * size, m, blockLength(m, rb, size), blockLength(n, cb, size));
+        }
+    }
+}
+
+// Writes updates random values in pairs of mirrored elements, which keep the symmetry of the matrix. round selects
+// the positions and the values, so that every round updates different elements
+void updateRound(struct TrackedMatrix* tracked, unsigned long long round, size_t updates) {
+    for (unsigned long long u = 0; u < updates; u++) {
+        const unsigned long long key = mix64(workload.seed ^ mix64(round * TRACKED_DENSITY_MAX + u));
+        const size_t i = key % tracked->n;
+        const size_t j = (key >> 32) % tracked->n;
+        const double value = (mix64(key) >> 11) * 0x1.0p-53;
+        setTracked(tracked, i, j, value);
+        setTracked(tracked, j, i, value);
+    }
+}
+
+// The attribute is necessary to avoid the compiler optimization on the repetitions loops
+int __attribute__((optimize("O0"))) main(int argc, char** argv) {
+#ifdef _OPENMP
+    printf("Compiled with OpenMP %d.%02d\n", _OPENMP / 100, _OPENMP % 100);
+#else
+    printf("Error: compile with -fopenmp flag");
+#endif
+
+    size_t m = 0;
+    size_t n = 0;
+    int rep = 0;
+    int threads = 0;
+    if (parseArguments(argc, argv, &m, &n, &rep, &threads) == -1) {
+        return 1;
+    }
+    if (m != n) {
+        printf("Error: symmetry tracking needs a square matrix!\n\n");
+        return 1;
+    }
+
+    printf("Matrix dimensions: %zu x %zu\n", m, n);
+    printf("Repetitions: %d\n", rep);
+    printf("Updates per query: %d pairs of elements\n\n", TRACKED_UPDATES);
+
+    // Variables declaration
+    double ts, te, t1, t2, t3, t4, t5;    // execution times of the full check, of the updates, of the tracked check, of
+                                          // the full transpose and of the refresh of the transpose
+    bool symmetric = false;               // full symmetry check
+    bool symmetric_tracked = false;       // tracked symmetry check
+    size_t checked = 0;                   // pairs checked by the tracked queries
+    unsigned long long round = 0;         // rounds of updates
+    struct TrackedMatrix tracked;         // tracking of M
+    double* M;                            // input matrix
+    double* T;                            // transposed matrix
+
+    // Matrices allocation
+    if (initMatrices(&M, &T, m, n) == -1 || initTracked(&tracked, M, n) == -1 || attachTranspose(&tracked, T) == -1) {
+        printf("Error in allocating matrices!\n\n");
+        return -1;
+    }
+    checkSymTracked(&tracked);    // the first query checks all the pairs
+    refreshTranspose(&tracked);   // the first refresh transposes all the tiles
+
+    printf("Results: threads (T), symmetry (S), time in milliseconds of the full symmetry check (F), of the updates (U) and of the tracked ");
+    printf("symmetry check (TC), pairs of blocks checked by the tracked symmetry check out of the total (P), speedup of the tracked check (TS)\n\n");
+    printf("\t|\tT\t|\tS\t|\tF\t|\tU\t|\tTC\t|\tP\t\t|\tTS\t|\n");
+
+    // Executions, every repetition updates the matrix before the queries
+    for (int i = nextThreads(0, threads, true); i != 0; i = nextThreads(i, threads, true)) {  // the sequential and the passed threads
+        omp_set_num_threads(i);
+
+        t1 = t2 = t3 = 0;
+        checked = 0;
+        for (int j = 0; j < rep; j++) {
+            ts = omp_get_wtime();
+            updateRound(&tracked, round++, TRACKED_UPDATES);
+            te = omp_get_wtime();
+            t2 += te - ts;
+
+            ts = omp_get_wtime();
+            symmetric_tracked = checkSymTracked(&tracked);
+            te = omp_get_wtime();
+            t3 += te - ts;
+            checked += tracked.checked;
+
+            ts = omp_get_wtime();
+            symmetric = checkSymOMP(M, m, n);
+            te = omp_get_wtime();
+            t1 += te - ts;
+        }
+        t1 /= rep;
+        t2 /= rep;
+        t3 /= rep;
+
+        if (symmetric != symmetric_tracked) printf("Error: the tracked check returned symmetry %d!\n", symmetric_tracked);
+
+        // Results printing and saving
+        double speedup = t1 / t3;
+
+        printf("\t| %d\t\t| %d\t\t| %8.4f\t| %8.4f\t| %8.4f\t| %zu / %zu\t| %8.4f\t|\n", i, symmetric, t1 * 1e3, t2 * 1e3, t3 * 1e3, checked / rep,
+               tracked.blocks * (tracked.blocks + 1) / 2, speedup);
+
+        if (saveResultsTracked(CODE, m, n, i, TRACKED_UPDATES, (double)checked / rep, t1, t2, t3, speedup) == -1) {
+            printf("Error in saving results!\n\n");
+        }
+    }
+
+    printf("\nResults of the refresh of the transpose: threads (T), pairs of elements written between two refreshes (D), time in milliseconds ");
+    printf("of the full transpose (F) and of the refresh (R), elements copied (EC) or tiles transposed (TT) by the refresh, speedup of the refresh (RS)\n\n");
+    printf("\t|\tT\t|\tD\t|\tF\t|\tR\t|\tEC\t|\tTT\t|\tRS\t|\n");
+
+    for (int i = nextThreads(0, threads, true); i != 0; i = nextThreads(i, threads, true)) {  // the sequential and the passed threads
+        omp_set_num_threads(i);
+
+        ts = omp_get_wtime();
+        for (int j = 0; j < rep; j++) matTransposeOMP(M, T, m, n);
+        te = omp_get_wtime();
+        t4 = (te - ts) / rep;
+
+        for (size_t density = 1; density <= TRACKED_DENSITY_MAX; density *= 4) {
+            size_t patched = 0, refreshed = 0;  // elements copied and tiles transposed by the refreshes
+            refreshTranspose(&tracked);         // the writes of the previous measures are not timed
+            t5 = 0;
+            for (int j = 0; j < rep; j++) {
+                updateRound(&tracked, round++, density);
+                ts = omp_get_wtime();
+                refreshTranspose(&tracked);
+                te = omp_get_wtime();
+                t5 += te - ts;
+                patched += tracked.patched;
+                refreshed += tracked.refreshed;
+            }
+            t5 /= rep;
+
+            double speedup = t4 / t5;
+
+            printf("\t| %d\t\t| %zu\t\t| %8.4f\t| %8.4f\t| %zu\t\t| %zu\t\t| %8.4f\t|\n", i, density, t4 * 1e3, t5 * 1e3, patched / rep, refreshed / rep, speedup);
+
+            if (saveResultsTrackedTranspose(CODE, m, n, i, density, (double)patched / rep, (double)refreshed / rep, t4, t5, speedup) == -1) {
+                printf("Error in saving results!\n\n");
+            }
+        }
+    }
+    // --------------------------------
+
+    // An asymmetric write and its undo must change the tracked symmetry like the full one
+    printf("\n");
+    bool correct = checkSymTracked(&tracked) == checkSymOMP(M, m, n);
+    if (n > 1) {
+        const double saved = M[(n - 1) * n];
+        setTracked(&tracked, n - 1, 0, saved + 1);
+        correct = correct && checkSymTracked(&tracked) == checkSymOMP(M, m, n);
+        setTracked(&tracked, n - 1, 0, saved);
+        correct = correct && checkSymTracked(&tracked) == checkSymOMP(M, m, n);
+    }
+    printf("Tested tracking: tracked symmetry %s.\n", correct ? "correct" : "incorrect");
+    refreshTranspose(&tracked);  // T is verified as maintained by the refreshes
+    testResults(M, T, m, n);
+
+    // Matrices deallocation
+    freeTracked(&tracked);
+    free(M);
+    free(T);
+
+    return 0;
+}
\ No newline at end of file
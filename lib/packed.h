@@ -0,0 +1,107 @@
+#ifndef PACKED_H
+#define PACKED_H
+
+#include "simd.h"
+
+// Packed storage of symmetric matrices: only the lower triangular part (diagonal included) of an n x n matrix is
+// kept, n * (n + 1) / 2 doubles instead of n * n.
+// - PACKED_LOWER: the rows of the lower triangular part one after the other, element (i, j) with j <= i at
+//   i * (i + 1) / 2 + j (the row-major counterpart of the LAPACK packed format);
+// - PACKED_RFP: rectangular full packed format of LAPACK (TRANSR = 'N', UPLO = 'L'), a column-major array of
+//   n + 1 rows (n even) or n rows (n odd) and (n + 1) / 2 columns holding the first (n + 1) / 2 columns of the lower
+//   triangular part and the transpose of the trailing lower triangle, which can be passed to the RFP routines of
+//   LAPACK (dpftrf, dsfrk, ...) and to level 3 BLAS on its two triangles and its rectangular part.
+
+#define PACKED_LOWER 0
+#define PACKED_RFP 1
+
+#define PACK_BLOCK 32
+
+size_t packedSize(size_t n) {
+    return n * (n + 1) / 2;
+}
+
+// Index of the element (i, j) with j <= i of the lower triangular part in the packed layout
+static inline size_t packedIndex(size_t n, int layout, size_t i, size_t j) {
+    if (layout == PACKED_LOWER) return i * (i + 1) / 2 + j;
+
+    const size_t k = (n + 1) / 2;   // columns of the RFP array
+    const size_t even = n % 2 == 0;
+    const size_t ld = n + even;     // rows of the RFP array
+    if (j < k) return i + even + j * ld;  // leading columns, shifted down by a row when n is even
+    return j - k + (i - k + 1 - even) * ld;  // trailing triangle, transposed in the top rows
+}
+
+// Element (i, j) of the packed symmetric matrix, from either triangular part
+static inline double packedElement(const double* P, size_t n, int layout, size_t i, size_t j) {
+    return i >= j ? P[packedIndex(n, layout, i, j)] : P[packedIndex(n, layout, j, i)];
+}
+
+// Packs the lower triangular part of the square matrix M into P, by pairs of blocks (rb, cb) and (cb, rb) in parallel.
+// With verify the block of the higher triangular part is compared with the packed one in the same pass, like the
+// symmetry check, and the symmetry of M is returned: P holds M only if it is true. Without verify only the lower
+// triangular part is read and true is returned.
+bool packSymmetric(const double* M, double* P, size_t n, int layout, bool verify) {
+    const size_t size = PACK_BLOCK < n ? PACK_BLOCK : n;
+    const size_t blocks = blockCount(n, size);
+    bool check = true;
+
+#pragma omp parallel for schedule(dynamic, 1) reduction(&& : check)
+    for (size_t rb = 0; rb < blocks; rb++) {                 // row blocks indexing
+        for (size_t cb = 0; cb <= rb; cb++) {                // column blocks indexing
+            const double* first = M + (rb * n + cb) * size;  // block matrix of lower triangular part
+            const double* last = M + (cb * n + rb) * size;   // block matrix of higher triangular part
+            const size_t rows = blockLength(n, rb, size);    // edge blocks can be smaller
+            const size_t cols = blockLength(n, cb, size);
+            if (verify) check &= checkBlock(first, last, n, rows, cols, rb == cb);  // the pair is still in the caches below
+            for (size_t i = 0; i < rows; i++) {
+                const size_t row = rb * size + i;
+                for (size_t j = 0; j < (rb == cb ? i + 1 : cols); j++) {
+                    P[packedIndex(n, layout, row, cb * size + j)] = first[i * n + j];
+                }
+            }
+        }
+    }
+
+    return check;
+}
+
+// Unpacks P into the square matrix M, by pairs of blocks in parallel: the block of the lower triangular part is
+// copied from P and transposed in registers into its mirror block
+void unpackSymmetric(const double* P, double* M, size_t n, int layout) {
+    const size_t size = PACK_BLOCK < n ? PACK_BLOCK : n;
+    const size_t blocks = blockCount(n, size);
+
+#pragma omp parallel for schedule(dynamic, 1)
+    for (size_t rb = 0; rb < blocks; rb++) {           // row blocks indexing
+        for (size_t cb = 0; cb <= rb; cb++) {          // column blocks indexing
+            double* first = M + (rb * n + cb) * size;  // block matrix of lower triangular part
+            double* last = M + (cb * n + rb) * size;   // block matrix of higher triangular part
+            const size_t rows = blockLength(n, rb, size);
+            const size_t cols = blockLength(n, cb, size);
+            for (size_t i = 0; i < rows; i++) {
+                const size_t row = rb * size + i;
+                for (size_t j = 0; j < (rb == cb ? i + 1 : cols); j++) {
+                    first[i * n + j] = P[packedIndex(n, layout, row, cb * size + j)];
+                }
+            }
+            if (rb != cb) {
+                transposeBlock(first, n, last, n, rows, cols);
+            } else {
+                for (size_t i = 0; i < rows; i++) {  // higher half of the diagonal block
+                    for (size_t j = i + 1; j < cols; j++) first[i * n + j] = first[j * n + i];
+                }
+            }
+        }
+    }
+}
+
+// A symmetric matrix is its own transpose: the transpose of a packed symmetric matrix is a view of the same array,
+// nothing is moved. Elements are read through packedElement, swapping the indices when needed.
+const double* matTransposePacked(const double* P, size_t n, int layout) {
+    (void)n;
+    (void)layout;
+    return P;
+}
+
+#endif
\ No newline at end of file
@@ -9,14 +9,15 @@
 
 #define CODE "S"
 
-bool checkSym(double* M, int n) {
+bool checkSym(double* M, size_t m, size_t n) {
+    if (m != n) return false;  // only square matrices can be symmetric
     bool check = true;
 
     // M is symmetric if M[i][j] == M[j][i]
     // equality is checked wrt epsilon defined in "functions.h"
     // values on the main diagonal can be skipped since i == j
-    for (int i = 1; i < n; i++) {
-        for (int j = 0; j < i; j++) {
+    for (size_t i = 1; i < n; i++) {
+        for (size_t j = 0; j < i; j++) {
             if (fabs(M[i * n + j] - M[j * n + i]) > EPSILON) {
                 check = false;
             }
@@ -26,33 +27,26 @@ bool checkSym(double* M, int n) {
     return check;
 }
 
-void matTranspose(double* M, double* T, int n) {
+void matTranspose(double* M, double* T, size_t m, size_t n) {
     // T is the transpose of M if M[i][j] == T[j][i]
     // values on the main diagonal must be copied
-    for (int i = 0; i < n; i++) {
-        for (int j = 0; j < n; j++) {
-            T[j * n + i] = M[i * n + j];
+    for (size_t i = 0; i < m; i++) {
+        for (size_t j = 0; j < n; j++) {
+            T[j * m + i] = M[i * n + j];
         }
     }
 }
 
 // The attribute is necessary to avoid the compiler optimization on the repetitions loops
 int __attribute__((optimize("O0"))) main(int argc, char** argv) {
-    int dim = 0;
+    size_t m = 0;
+    size_t n = 0;
     int rep = 0;
-    if (argc < 2) {
-        printf("Correct usage: program-name [M dimension as exponent of 2] [number of repetitions (default 5)]");
+    if (parseArguments(argc, argv, &m, &n, &rep, NULL) == -1) {
         return 1;
-    } else if (argc == 2) {
-        dim = atoi(argv[1]);
-        rep = 500;
-    } else {
-        dim = atoi(argv[1]);
-        rep = atoi(argv[2]) > 0 ? atoi(argv[2]) : 500;
     }
 
-    unsigned int n = pow(2, dim);
-    printf("Matrix dimension: %d\n\n", n);
+    printf("Matrix dimensions: %zu x %zu\n\n", m, n);
     printf("Repetitions: %d\n\n", rep);
 
     // Variables declaration
@@ -63,18 +57,18 @@ int __attribute__((optimize("O0"))) main(int argc, char** argv) {
     double* T;                        // transposed matrix
 
     // Matrices allocation
-    if (initMatrices(&M, &T, n) == -1) {
+    if (initMatrices(&M, &T, m, n) == -1) {
         printf("Error in allocating matrices!\n\n");
         return -1;
     }
 
     // Sequential execution
     clock_gettime(CLOCK_MONOTONIC, &s1);
-    for (int i = 0; i < rep; i++) symmetric = checkSym(M, n);
+    for (int i = 0; i < rep; i++) symmetric = checkSym(M, m, n);
     clock_gettime(CLOCK_MONOTONIC, &e1);
 
     clock_gettime(CLOCK_MONOTONIC, &s2);
-    for (int i = 0; i < rep; i++) matTranspose(M, T, n);
+    for (int i = 0; i < rep; i++) matTranspose(M, T, m, n);
     clock_gettime(CLOCK_MONOTONIC, &e2);
     // --------------------------------
 
@@ -82,16 +76,16 @@ int __attribute__((optimize("O0"))) main(int argc, char** argv) {
     t1 = elapsedTime(s1, e1) / rep;
     t2 = elapsedTime(s2, e2) / rep;
 
-    flops = (double)((n * n) / 2 - n) / t1;
-    bandwidth = (double)(2 * n * n * sizeof(double)) / t2;
+    flops = m == n ? ((double)n * n / 2 - n) / t1 : 0;  // rectangular matrices are not checked
+    bandwidth = (double)(2 * m * n * sizeof(double)) / t2;
 
     printf("Sequential execution: symmetry: %s\n", symmetric ? "true" : "false");
     printf("checkSym:\t%.9f seconds\t%10.4g GFLOPS\n", t1, flops * 1e-9);
     printf("matTranspose:\t%.9f seconds\t%10.4g GB/s\n\n", t2, bandwidth * 1e-9);
 
-    testResults(M, T, n);
+    testResults(M, T, m, n);
 
-    if (saveResultsILP(CODE, n, flops, bandwidth) == -1) {
+    if (saveResultsILP(CODE, m, n, flops, bandwidth) == -1) {
         printf("Error in saving results!\n\n");
     }
 
@@ -0,0 +1,343 @@
+#ifndef SIMD_H
+#define SIMD_H
+
+#include <immintrin.h>
+#include <stdint.h>
+
+// Width in doubles of the register tiles: 8x8 with AVX-512, 4x4 with AVX2, scalar code otherwise.
+// The width is selected at compile time from the flags (-mavx512f, -mavx2) passed to gcc.
+#if defined(__AVX512F__)
+#define SIMD_WIDTH 8
+#elif defined(__AVX2__)
+#define SIMD_WIDTH 4
+#else
+#define SIMD_WIDTH 1
+#endif
+
+// Size in bytes of T above which the transpose writes it with streaming stores, by default the size of the LLC
+// of the nodes (36 MB). It can be tuned at compile time with -DSTREAM_THRESHOLD=...
+#ifndef STREAM_THRESHOLD
+#define STREAM_THRESHOLD (36UL * 1024 * 1024)
+#endif
+
+#if defined(__AVX512F__)
+// Transposes in registers the 8x8 tile held in r[0..7] (one row per register)
+static inline void transposeRegisters(__m512d* r) {
+    // interleaving pairs of rows: t0 = [r0_0 r1_0 r0_2 r1_2 r0_4 r1_4 r0_6 r1_6]
+    __m512d t0 = _mm512_unpacklo_pd(r[0], r[1]);
+    __m512d t1 = _mm512_unpackhi_pd(r[0], r[1]);
+    __m512d t2 = _mm512_unpacklo_pd(r[2], r[3]);
+    __m512d t3 = _mm512_unpackhi_pd(r[2], r[3]);
+    __m512d t4 = _mm512_unpacklo_pd(r[4], r[5]);
+    __m512d t5 = _mm512_unpackhi_pd(r[4], r[5]);
+    __m512d t6 = _mm512_unpacklo_pd(r[6], r[7]);
+    __m512d t7 = _mm512_unpackhi_pd(r[6], r[7]);
+
+    // merging pairs of 128-bit lanes: u0 = [r0_0 r1_0 r2_0 r3_0 r0_4 r1_4 r2_4 r3_4]
+    const __m512i low = _mm512_set_epi64(13, 12, 5, 4, 9, 8, 1, 0);
+    const __m512i high = _mm512_set_epi64(15, 14, 7, 6, 11, 10, 3, 2);
+    __m512d u0 = _mm512_permutex2var_pd(t0, low, t2);
+    __m512d u1 = _mm512_permutex2var_pd(t1, low, t3);
+    __m512d u2 = _mm512_permutex2var_pd(t0, high, t2);
+    __m512d u3 = _mm512_permutex2var_pd(t1, high, t3);
+    __m512d u4 = _mm512_permutex2var_pd(t4, low, t6);
+    __m512d u5 = _mm512_permutex2var_pd(t5, low, t7);
+    __m512d u6 = _mm512_permutex2var_pd(t4, high, t6);
+    __m512d u7 = _mm512_permutex2var_pd(t5, high, t7);
+
+    // merging 256-bit halves of the top and bottom rows: columns 0-3 and 4-7 of the tile
+    r[0] = _mm512_shuffle_f64x2(u0, u4, 0x44);
+    r[1] = _mm512_shuffle_f64x2(u1, u5, 0x44);
+    r[2] = _mm512_shuffle_f64x2(u2, u6, 0x44);
+    r[3] = _mm512_shuffle_f64x2(u3, u7, 0x44);
+    r[4] = _mm512_shuffle_f64x2(u0, u4, 0xEE);
+    r[5] = _mm512_shuffle_f64x2(u1, u5, 0xEE);
+    r[6] = _mm512_shuffle_f64x2(u2, u6, 0xEE);
+    r[7] = _mm512_shuffle_f64x2(u3, u7, 0xEE);
+}
+
+// Transposes the 8x8 tile at source (row stride ld_source) into destination (row stride ld_destination)
+static inline void transposeTile(const double* source, size_t ld_source, double* destination, size_t ld_destination) {
+    __m512d r[8];
+    for (int i = 0; i < 8; i++) r[i] = _mm512_loadu_pd(source + i * ld_source);
+    transposeRegisters(r);
+    for (int i = 0; i < 8; i++) _mm512_storeu_pd(destination + i * ld_destination, r[i]);
+}
+
+// Same as transposeTile, writing the rows of destination (aligned to 64 bytes) with non-temporal stores
+static inline void transposeTileStream(const double* source, size_t ld_source, double* destination, size_t ld_destination) {
+    __m512d r[8];
+    for (int i = 0; i < 8; i++) r[i] = _mm512_loadu_pd(source + i * ld_source);
+    transposeRegisters(r);
+    for (int i = 0; i < 8; i++) _mm512_stream_pd(destination + i * ld_destination, r[i]);
+}
+
+// Compares the 8x8 tile at first with the transpose of the 8x8 tile at last (both with row stride n).
+// Only the lanes enabled in lanes[i] are compared for row i, the result is non zero if any of them differs.
+static inline int compareTile(const double* first, const double* last, size_t n, const __mmask8* lanes) {
+    const __m512d epsilon_vec = _mm512_set1_pd(EPSILON);
+    __mmask8 mismatch = 0;
+    __m512d r[8];
+
+    for (int i = 0; i < 8; i++) r[i] = _mm512_loadu_pd(last + i * n);
+    transposeRegisters(r);
+    for (int i = 0; i < 8; i++) {
+        __m512d abs_diff = _mm512_abs_pd(_mm512_sub_pd(_mm512_loadu_pd(first + i * n), r[i]));
+        mismatch |= _mm512_mask_cmp_pd_mask(lanes[i], abs_diff, epsilon_vec, _CMP_GT_OQ);
+    }
+
+    return mismatch;
+}
+
+// Lanes compared in each row: all of them (off-diagonal tiles) or the strictly lower part (diagonal tiles)
+static inline void tileLanes(__mmask8* full, __mmask8* lower) {
+    for (int i = 0; i < 8; i++) {
+        full[i] = 0xFF;
+        lower[i] = (1 << i) - 1;
+    }
+}
+#elif defined(__AVX2__)
+// Transposes in registers the 4x4 tile held in r[0..3] (one row per register)
+static inline void transposeRegisters(__m256d* r) {
+    // interleaving pairs of rows: t0 = [r0_0 r1_0 r0_2 r1_2]
+    __m256d t0 = _mm256_unpacklo_pd(r[0], r[1]);
+    __m256d t1 = _mm256_unpackhi_pd(r[0], r[1]);
+    __m256d t2 = _mm256_unpacklo_pd(r[2], r[3]);
+    __m256d t3 = _mm256_unpackhi_pd(r[2], r[3]);
+
+    // merging 128-bit lanes: [r0_0 r1_0 r2_0 r3_0]
+    r[0] = _mm256_permute2f128_pd(t0, t2, 0x20);
+    r[1] = _mm256_permute2f128_pd(t1, t3, 0x20);
+    r[2] = _mm256_permute2f128_pd(t0, t2, 0x31);
+    r[3] = _mm256_permute2f128_pd(t1, t3, 0x31);
+}
+
+// Transposes the 4x4 tile at source (row stride ld_source) into destination (row stride ld_destination)
+static inline void transposeTile(const double* source, size_t ld_source, double* destination, size_t ld_destination) {
+    __m256d r[4];
+    for (int i = 0; i < 4; i++) r[i] = _mm256_loadu_pd(source + i * ld_source);
+    transposeRegisters(r);
+    for (int i = 0; i < 4; i++) _mm256_storeu_pd(destination + i * ld_destination, r[i]);
+}
+
+// Same as transposeTile, writing the rows of destination (aligned to 32 bytes) with non-temporal stores
+static inline void transposeTileStream(const double* source, size_t ld_source, double* destination, size_t ld_destination) {
+    __m256d r[4];
+    for (int i = 0; i < 4; i++) r[i] = _mm256_loadu_pd(source + i * ld_source);
+    transposeRegisters(r);
+    for (int i = 0; i < 4; i++) _mm256_stream_pd(destination + i * ld_destination, r[i]);
+}
+
+// Compares the 4x4 tile at first with the transpose of the 4x4 tile at last (both with row stride n).
+// Only the lanes enabled in lanes[i] are compared for row i, the result is non zero if any of them differs.
+static inline int compareTile(const double* first, const double* last, size_t n, const __m256d* lanes) {
+    const __m256d epsilon_vec = _mm256_set1_pd(EPSILON);
+    const __m256d sign = _mm256_set1_pd(-0.0);
+    __m256d mismatch = _mm256_setzero_pd();
+    __m256d r[4];
+
+    for (int i = 0; i < 4; i++) r[i] = _mm256_loadu_pd(last + i * n);
+    transposeRegisters(r);
+    for (int i = 0; i < 4; i++) {
+        __m256d abs_diff = _mm256_andnot_pd(sign, _mm256_sub_pd(_mm256_loadu_pd(first + i * n), r[i]));
+        mismatch = _mm256_or_pd(mismatch, _mm256_and_pd(lanes[i], _mm256_cmp_pd(abs_diff, epsilon_vec, _CMP_GT_OQ)));
+    }
+
+    return _mm256_movemask_pd(mismatch);
+}
+
+// Lanes compared in each row: all of them (off-diagonal tiles) or the strictly lower part (diagonal tiles)
+static inline void tileLanes(__m256d* full, __m256d* lower) {
+    const __m256d columns = _mm256_set_pd(3, 2, 1, 0);
+    for (int i = 0; i < 4; i++) {
+        full[i] = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+        lower[i] = _mm256_cmp_pd(columns, _mm256_set1_pd(i), _CMP_LT_OQ);
+    }
+}
+#endif
+
+// Transposes a rows x cols block of source (row stride ld_source) into destination (row stride ld_destination):
+// destination[j][i] = source[i][j]. The block is covered with SIMD_WIDTH x SIMD_WIDTH register tiles, the edge
+// rows and columns that do not fill a whole tile (or the whole block without SIMD support) are copied with
+// scalar code, so blocks of any size can be transposed.
+static inline void transposeBlock(const double* source, size_t ld_source, double* destination, size_t ld_destination, size_t rows, size_t cols) {
+#if SIMD_WIDTH > 1
+    const size_t tiled_rows = rows - rows % SIMD_WIDTH;
+    const size_t tiled_cols = cols - cols % SIMD_WIDTH;
+
+    for (size_t i = 0; i < tiled_rows; i += SIMD_WIDTH) {
+        for (size_t j = 0; j < tiled_cols; j += SIMD_WIDTH) {
+            transposeTile(source + i * ld_source + j, ld_source, destination + j * ld_destination + i, ld_destination);
+        }
+    }
+#else
+    const size_t tiled_rows = 0;
+    const size_t tiled_cols = 0;
+#endif
+
+    for (size_t i = 0; i < rows; i++) {  // elements outside of the tiles
+        for (size_t j = i < tiled_rows ? tiled_cols : 0; j < cols; j++) {
+            destination[j * ld_destination + i] = source[i * ld_source + j];
+        }
+    }
+}
+
+// Streaming stores write the lines of T without reading them first (no read-for-ownership), which saves a third
+// of the memory traffic once T does not fit in the LLC. They need every register tile row of T to be aligned to
+// SIMD_WIDTH doubles: T aligned, m and the block size multiple of SIMD_WIDTH.
+static inline bool useStreaming(const double* T, size_t m, size_t n, size_t size) {
+#if SIMD_WIDTH > 1
+    return m * n * sizeof(double) > STREAM_THRESHOLD && (uintptr_t)T % (SIMD_WIDTH * sizeof(double)) == 0 && m % SIMD_WIDTH == 0 && size % SIMD_WIDTH == 0;
+#else
+    return false;
+#endif
+}
+
+// Same as transposeBlock, writing the register tiles with streaming stores (the scalar edges use regular stores).
+// The stores are weakly ordered: an _mm_sfence is needed before T is read by other threads.
+static inline void transposeBlockStream(const double* source, size_t ld_source, double* destination, size_t ld_destination, size_t rows, size_t cols) {
+#if SIMD_WIDTH > 1
+    const size_t tiled_rows = rows - rows % SIMD_WIDTH;
+    const size_t tiled_cols = cols - cols % SIMD_WIDTH;
+
+    for (size_t i = 0; i < tiled_rows; i += SIMD_WIDTH) {
+        for (size_t j = 0; j < tiled_cols; j += SIMD_WIDTH) {
+            transposeTileStream(source + i * ld_source + j, ld_source, destination + j * ld_destination + i, ld_destination);
+        }
+    }
+
+    for (size_t i = 0; i < rows; i++) {  // elements outside of the tiles
+        for (size_t j = i < tiled_rows ? tiled_cols : 0; j < cols; j++) {
+            destination[j * ld_destination + i] = source[i * ld_source + j];
+        }
+    }
+#else
+    transposeBlock(source, ld_source, destination, ld_destination, rows, cols);
+#endif
+}
+
+// Checks the symmetry of a pair of blocks of a square matrix with n columns: first[i][j] == last[j][i] for
+// i < rows and j < cols. Diagonal blocks (first == last, rows == cols) only compare their strictly lower half.
+// Every SIMD_WIDTH x SIMD_WIDTH tile of first is compared with the in-register transpose of its mirror tile in
+// last and the compare masks are accumulated without branches, the edge rows and columns are compared with
+// scalar code. Without SIMD support the original scalar loop is kept.
+static inline bool checkBlock(const double* first, const double* last, size_t n, size_t rows, size_t cols, bool diagonal) {
+#if SIMD_WIDTH > 1
+    const size_t tiled_rows = rows - rows % SIMD_WIDTH;
+    const size_t tiled_cols = cols - cols % SIMD_WIDTH;
+    int mismatch = 0;
+
+#if defined(__AVX512F__)
+    __mmask8 full[SIMD_WIDTH], lower[SIMD_WIDTH];
+#else
+    __m256d full[SIMD_WIDTH], lower[SIMD_WIDTH];
+#endif
+    tileLanes(full, lower);
+
+    for (size_t i = 0; i < tiled_rows; i += SIMD_WIDTH) {
+        for (size_t j = 0; j < (diagonal ? i : tiled_cols); j += SIMD_WIDTH) {
+            mismatch |= compareTile(first + i * n + j, last + j * n + i, n, full);
+        }
+        if (diagonal) mismatch |= compareTile(first + i * n + i, last + i * n + i, n, lower);
+    }
+
+    for (size_t i = 0; i < rows; i++) {  // elements outside of the tiles
+        for (size_t j = i < tiled_rows ? tiled_cols : 0; j < (diagonal ? i : cols); j++) {
+            mismatch |= fabs(first[i * n + j] - last[j * n + i]) > EPSILON;
+        }
+    }
+
+    return mismatch == 0;
+#else
+    bool check = true;
+    for (size_t i = 0; i < rows; i++) {
+        for (size_t j = 0; j < cols; j++) {
+            if (fabs(first[i * n + j] - last[j * n + i]) > EPSILON) {
+                check = false;
+            }
+        }
+    }
+
+    return check;
+#endif
+}
+
+// Fused symmetry check and transpose of a pair of blocks of a square matrix with n columns: compares first[i][j]
+// with last[j][i] like checkBlock and writes the transpose of both blocks in T (row stride n), last transposed at
+// t_first (the position of first in T) and first transposed at t_last. Every tile pair is loaded once: the mirror
+// tile is transposed in registers, compared with the tile of first and stored, then the tile of first is
+// transposed and stored. Diagonal blocks (first == last) are written once, with their diagonal elements.
+static inline bool checkTransposeBlock(const double* first, const double* last, double* t_first, double* t_last, size_t n, size_t rows, size_t cols,
+                                       bool diagonal) {
+    int mismatch = 0;
+#if SIMD_WIDTH > 1
+    const size_t tiled_rows = rows - rows % SIMD_WIDTH;
+    const size_t tiled_cols = cols - cols % SIMD_WIDTH;
+
+#if defined(__AVX512F__)
+    const __m512d epsilon_vec = _mm512_set1_pd(EPSILON);
+    __mmask8 full[SIMD_WIDTH], lower[SIMD_WIDTH];
+    __m512d a[SIMD_WIDTH], b[SIMD_WIDTH];
+#else
+    const __m256d epsilon_vec = _mm256_set1_pd(EPSILON);
+    const __m256d sign = _mm256_set1_pd(-0.0);
+    __m256d full[SIMD_WIDTH], lower[SIMD_WIDTH], mismatch_vec = _mm256_setzero_pd();
+    __m256d a[SIMD_WIDTH], b[SIMD_WIDTH];
+#endif
+    tileLanes(full, lower);
+
+    for (size_t i = 0; i < tiled_rows; i += SIMD_WIDTH) {
+        for (size_t j = 0; j < (diagonal ? i + SIMD_WIDTH : tiled_cols); j += SIMD_WIDTH) {
+            const bool on_diagonal = diagonal && i == j;  // the tile is its own mirror
+#if defined(__AVX512F__)
+            for (int k = 0; k < SIMD_WIDTH; k++) {
+                a[k] = _mm512_loadu_pd(first + (i + k) * n + j);
+                b[k] = _mm512_loadu_pd(last + (j + k) * n + i);
+            }
+            transposeRegisters(b);
+            for (int k = 0; k < SIMD_WIDTH; k++) {
+                __m512d abs_diff = _mm512_abs_pd(_mm512_sub_pd(a[k], b[k]));
+                mismatch |= _mm512_mask_cmp_pd_mask(on_diagonal ? lower[k] : full[k], abs_diff, epsilon_vec, _CMP_GT_OQ);
+                _mm512_storeu_pd(t_first + (i + k) * n + j, b[k]);
+            }
+            if (on_diagonal) continue;
+            transposeRegisters(a);
+            for (int k = 0; k < SIMD_WIDTH; k++) _mm512_storeu_pd(t_last + (j + k) * n + i, a[k]);
+#else
+            for (int k = 0; k < SIMD_WIDTH; k++) {
+                a[k] = _mm256_loadu_pd(first + (i + k) * n + j);
+                b[k] = _mm256_loadu_pd(last + (j + k) * n + i);
+            }
+            transposeRegisters(b);
+            for (int k = 0; k < SIMD_WIDTH; k++) {
+                __m256d abs_diff = _mm256_andnot_pd(sign, _mm256_sub_pd(a[k], b[k]));
+                mismatch_vec = _mm256_or_pd(mismatch_vec, _mm256_and_pd(on_diagonal ? lower[k] : full[k], _mm256_cmp_pd(abs_diff, epsilon_vec, _CMP_GT_OQ)));
+                _mm256_storeu_pd(t_first + (i + k) * n + j, b[k]);
+            }
+            if (on_diagonal) continue;
+            transposeRegisters(a);
+            for (int k = 0; k < SIMD_WIDTH; k++) _mm256_storeu_pd(t_last + (j + k) * n + i, a[k]);
+#endif
+        }
+    }
+#if !defined(__AVX512F__)
+    mismatch = _mm256_movemask_pd(mismatch_vec);
+#endif
+#else
+    const size_t tiled_rows = 0;
+    const size_t tiled_cols = 0;
+#endif
+
+    for (size_t i = 0; i < rows; i++) {  // elements outside of the tiles
+        for (size_t j = i < tiled_rows ? tiled_cols : 0; j < (diagonal ? i + 1 : cols); j++) {
+            const double x = first[i * n + j];
+            const double y = last[j * n + i];
+            mismatch |= fabs(x - y) > EPSILON;
+            t_first[i * n + j] = y;
+            t_last[j * n + i] = x;
+        }
+    }
+
+    return mismatch == 0;
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,235 @@
+#ifndef TRACKED_H
+#define TRACKED_H
+
+#include <stdint.h>
+
+#include "simd.h"
+
+// Tracked symmetric matrix: a square matrix whose writes go through setTracked and updateTracked, so that the
+// symmetry can be checked again after a few updates without reading the whole matrix. The matrix is divided in pairs
+// of blocks (rb, cb) and (cb, rb) with cb <= rb, like the blocked symmetry check; every pair has a dirty bit, set by
+// the writes to either block, and a cached status bit, set while the pair is known to be asymmetric. A query only
+// checks the dirty pairs, in parallel, so its cost scales with the updates instead of n^2.
+// Writes to M that bypass the update API are not seen: markTracked marks a region dirty after them.
+// With attachTranspose the tracked matrix also keeps its transpose T: the writes mark their tiles of M stale, and
+// refreshTranspose transposes again only the stale tiles or, when the updates are very sparse, copies the written
+// elements, recorded in a log, directly in T.
+
+#define TRACK_BLOCK 32
+
+// Capacity of the log of the written elements: after more writes (or after a region update) T is refreshed by tiles
+#ifndef TRACK_PATCHES
+#define TRACK_PATCHES 65536
+#endif
+
+// Written elements per stale tile below which refreshTranspose copies the elements instead of transposing the tiles:
+// a copy touches a cache line of M and one of T, a tile transpose 2 * TRACK_BLOCK lines read and written in order.
+// It can be tuned at compile time with -DTRACK_PATCH_RATIO=...
+#ifndef TRACK_PATCH_RATIO
+#define TRACK_PATCH_RATIO TRACK_BLOCK
+#endif
+
+struct TrackedMatrix {
+    double* M;             // the matrix, n x n
+    size_t n;
+    size_t blocks;         // blocks per side, pair (rb, cb) has index rb * blocks + cb
+    uint64_t* dirty;       // pairs written after the last query
+    uint64_t* asymmetric;  // pairs with a difference at the last query
+    size_t mismatches;     // pairs with a difference, the matrix is symmetric when it is 0
+    size_t checked;        // pairs checked by the last query
+    size_t* pending;       // dirty pairs (or stale tiles) gathered by the query (or by the refresh)
+    double* T;             // transpose of M kept up to date by refreshTranspose, NULL if not attached
+    uint64_t* stale;       // tiles (rb, cb) of M written after the last refresh, index rb * blocks + cb
+    size_t* patches;       // log of the written elements, index i * n + j
+    size_t patch_count;    // written elements, more than TRACK_PATCHES when the log is not usable
+    size_t patched;        // elements copied by the last refresh
+    size_t refreshed;      // tiles transposed by the last refresh
+};
+
+// Bitmap words of the pairs of an n x n matrix
+static inline size_t trackedWords(size_t blocks) {
+    return (blocks * blocks + 63) / 64;
+}
+
+void freeTracked(struct TrackedMatrix* tracked) {
+    free(tracked->dirty);
+    free(tracked->asymmetric);
+    free(tracked->pending);
+    free(tracked->stale);
+    free(tracked->patches);
+}
+
+// Tracks M (n x n): all the pairs start dirty, so the first query checks the whole matrix. Returns -1 if the
+// bitmaps cannot be allocated
+int initTracked(struct TrackedMatrix* tracked, double* M, size_t n) {
+    tracked->M = M;
+    tracked->n = n;
+    tracked->blocks = blockCount(n, TRACK_BLOCK < n ? TRACK_BLOCK : n);
+    tracked->dirty = malloc(trackedWords(tracked->blocks) * sizeof(uint64_t));
+    tracked->asymmetric = calloc(trackedWords(tracked->blocks), sizeof(uint64_t));
+    tracked->pending = malloc(tracked->blocks * tracked->blocks * sizeof(size_t));
+    tracked->stale = calloc(trackedWords(tracked->blocks), sizeof(uint64_t));
+    tracked->mismatches = 0;
+    tracked->checked = 0;
+    tracked->T = NULL;
+    tracked->patches = NULL;
+    tracked->patch_count = 0;
+    tracked->patched = 0;
+    tracked->refreshed = 0;
+
+    if (tracked->dirty == NULL || tracked->asymmetric == NULL || tracked->pending == NULL || tracked->stale == NULL) {
+        freeTracked(tracked);
+        return -1;
+    }
+    for (size_t w = 0; w < trackedWords(tracked->blocks); w++) tracked->dirty[w] = 0;
+    for (size_t rb = 0; rb < tracked->blocks; rb++) {
+        for (size_t cb = 0; cb <= rb; cb++) tracked->dirty[(rb * tracked->blocks + cb) / 64] |= 1ULL << (rb * tracked->blocks + cb) % 64;
+    }
+
+    return 0;
+}
+
+// Sets bit p of the bitmap, safe with concurrent writers
+static inline void markBit(uint64_t* bitmap, size_t p) {
+    const uint64_t bit = 1ULL << p % 64;
+    uint64_t word;
+
+#pragma omp atomic read
+    word = bitmap[p / 64];
+    if ((word & bit) == 0) {  // most updates find the bit already set
+#pragma omp atomic update
+        bitmap[p / 64] |= bit;
+    }
+}
+
+// Marks dirty the pair of the blocks holding element (i, j) and, with a transpose attached, its tile stale
+static inline void markElement(struct TrackedMatrix* tracked, size_t i, size_t j) {
+    const size_t size = TRACK_BLOCK < tracked->n ? TRACK_BLOCK : tracked->n;
+    const size_t rb = i / size > j / size ? i / size : j / size;  // the pair is indexed by its lower block
+    const size_t cb = i / size > j / size ? j / size : i / size;
+
+    markBit(tracked->dirty, rb * tracked->blocks + cb);
+    if (tracked->T != NULL) markBit(tracked->stale, i / size * tracked->blocks + j / size);
+}
+
+// Marks dirty the pairs of the blocks intersecting the region of rows x cols elements starting at (i, j). The elements
+// of the region are not logged, so T will be refreshed by tiles
+void markTracked(struct TrackedMatrix* tracked, size_t i, size_t j, size_t rows, size_t cols) {
+    const size_t size = TRACK_BLOCK < tracked->n ? TRACK_BLOCK : tracked->n;
+#pragma omp atomic write
+    tracked->patch_count = TRACK_PATCHES + 1;
+    for (size_t r = i / size * size; r < i + rows; r += size) {
+        for (size_t c = j / size * size; c < j + cols; c += size) markElement(tracked, r, c);
+    }
+}
+
+// Writes value in M[i][j], logging the element when a transpose is attached
+static inline void setTracked(struct TrackedMatrix* tracked, size_t i, size_t j, double value) {
+    tracked->M[i * tracked->n + j] = value;
+    markElement(tracked, i, j);
+
+    if (tracked->T != NULL) {
+        size_t k;
+#pragma omp atomic capture
+        k = tracked->patch_count++;
+        if (k < TRACK_PATCHES) tracked->patches[k] = i * tracked->n + j;
+    }
+}
+
+// Writes the region of rows x cols values (row stride ld) in M starting at (i, j)
+void updateTracked(struct TrackedMatrix* tracked, size_t i, size_t j, size_t rows, size_t cols, const double* values, size_t ld) {
+    for (size_t r = 0; r < rows; r++) {
+        for (size_t c = 0; c < cols; c++) tracked->M[(i + r) * tracked->n + j + c] = values[r * ld + c];
+    }
+    markTracked(tracked, i, j, rows, cols);
+}
+
+// Symmetry of the tracked matrix: the dirty pairs are gathered from the bitmap (a bit every pair, cheap to scan),
+// checked again in parallel and their status updated, the others keep the cached one
+bool checkSymTracked(struct TrackedMatrix* tracked) {
+    const size_t n = tracked->n;
+    const size_t size = TRACK_BLOCK < n ? TRACK_BLOCK : n;
+    const size_t blocks = tracked->blocks;
+    size_t count = 0;
+    long delta = 0;  // change of the pairs with a difference
+
+    for (size_t w = 0; w < trackedWords(blocks); w++) {
+        for (uint64_t bits = tracked->dirty[w]; bits != 0; bits &= bits - 1) tracked->pending[count++] = w * 64 + __builtin_ctzll(bits);
+        tracked->dirty[w] = 0;
+    }
+
+#pragma omp parallel for schedule(dynamic, 1) reduction(+ : delta)
+    for (size_t k = 0; k < count; k++) {
+        const size_t p = tracked->pending[k];
+        const size_t rb = p / blocks;
+        const size_t cb = p % blocks;
+        const double* first = tracked->M + (rb * n + cb) * size;  // block matrix of lower triangular part
+        const double* last = tracked->M + (cb * n + rb) * size;   // block matrix of higher triangular part
+        const bool symmetric = checkBlock(first, last, n, blockLength(n, rb, size), blockLength(n, cb, size), rb == cb);
+        uint64_t word;  // bits of the same word can be changed by other threads
+#pragma omp atomic read
+        word = tracked->asymmetric[p / 64];
+        if (symmetric == ((word >> p % 64) & 1)) {  // the status changed
+            delta += symmetric ? -1 : 1;
+#pragma omp atomic update
+            tracked->asymmetric[p / 64] ^= 1ULL << p % 64;
+        }
+    }
+
+    tracked->mismatches += delta;
+    tracked->checked = count;
+
+    return tracked->mismatches == 0;
+}
+
+// Keeps T (n x n) as the transpose of the tracked matrix from now on: all the tiles start stale, so the first refresh
+// transposes the whole matrix. Returns -1 if the log cannot be allocated
+int attachTranspose(struct TrackedMatrix* tracked, double* T) {
+    tracked->patches = malloc(TRACK_PATCHES * sizeof(size_t));
+    if (tracked->patches == NULL) return -1;
+
+    tracked->T = T;
+    tracked->patch_count = TRACK_PATCHES + 1;
+    for (size_t p = 0; p < tracked->blocks * tracked->blocks; p++) tracked->stale[p / 64] |= 1ULL << p % 64;
+
+    return 0;
+}
+
+// Brings T up to date with the writes to M since the last refresh. When the log holds every written element and
+// they are fewer than TRACK_PATCH_RATIO per stale tile they are copied in T in parallel, otherwise the stale tiles
+// are transposed again in parallel, like the blocks of matTransposeOMP
+void refreshTranspose(struct TrackedMatrix* tracked) {
+    const size_t n = tracked->n;
+    const size_t size = TRACK_BLOCK < n ? TRACK_BLOCK : n;
+    const size_t blocks = tracked->blocks;
+    const size_t patches = tracked->patch_count;
+    size_t count = 0;
+
+    for (size_t w = 0; w < trackedWords(blocks); w++) {
+        for (uint64_t bits = tracked->stale[w]; bits != 0; bits &= bits - 1) tracked->pending[count++] = w * 64 + __builtin_ctzll(bits);
+        tracked->stale[w] = 0;
+    }
+
+    if (patches <= TRACK_PATCHES && patches <= TRACK_PATCH_RATIO * count) {
+#pragma omp parallel for schedule(static)
+        for (size_t k = 0; k < patches; k++) {
+            const size_t e = tracked->patches[k];
+            tracked->T[e % n * n + e / n] = tracked->M[e];
+        }
+        tracked->patched = patches;
+        tracked->refreshed = 0;
+    } else {
+#pragma omp parallel for schedule(dynamic, 1)
+        for (size_t k = 0; k < count; k++) {
+            const size_t rb = tracked->pending[k] / blocks;
+            const size_t cb = tracked->pending[k] % blocks;
+            transposeBlock(tracked->M + (rb * n + cb) * size, n, tracked->T + (cb * n + rb) * size, n, blockLength(n, rb, size), blockLength(n, cb, size));
+        }
+        tracked->patched = 0;
+        tracked->refreshed = count;
+    }
+
+    tracked->patch_count = 0;
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,228 @@
+#ifndef TUNING_H
+#define TUNING_H
+
+#include <cpuid.h>
+#include <immintrin.h>
+#include <string.h>
+
+#define FILE_NAME_PROFILE "tuning_profiles.csv"
+
+// Loop orders inside the blocks: the inner loop runs along the rows of M (ROW_ORDER) or along the rows of T (COLUMN_ORDER)
+#define ROW_ORDER 0
+#define COLUMN_ORDER 1
+
+// Tunable parameters of a kernel, the defaults are the macros of the blocked programs (BLOCK_SIZE 32, no prefetching,
+// static schedule with the default chunk)
+struct Profile {
+    size_t block;  // side of the blocks
+    int order;     // loop order inside the blocks
+    int prefetch;  // distance in blocks of the software prefetch, 0 to disable it
+    int schedule;  // OpenMP schedule kind as omp_sched_t (1 static, 2 dynamic, 3 guided), unused by sequential kernels
+    int chunk;     // OpenMP chunk size, 0 for the default one
+};
+
+struct Profile defaultProfile(void) {
+    struct Profile profile = {32, ROW_ORDER, 0, 1, 0};
+    return profile;
+}
+
+// Brand string of the CPU read with cpuid (the "Model name" of lscpu), commas are removed to keep the profile a valid csv
+void cpuModel(char* model, size_t length) {
+    unsigned int brand[12];
+    char* start = (char*)brand;
+
+    for (unsigned int i = 0; i < 3; i++) {
+        if (!__get_cpuid(0x80000002 + i, &brand[4 * i], &brand[4 * i + 1], &brand[4 * i + 2], &brand[4 * i + 3])) {
+            snprintf(model, length, "unknown");
+            return;
+        }
+    }
+
+    while (*start == ' ') start++;
+    snprintf(model, length, "%.48s", start);
+    for (char* c = model; *c != '\0'; c++) {
+        if (*c == ',') *c = ' ';
+    }
+}
+
+// Size class of an m x n matrix: the exponent of the smallest power of two covering its longest side
+int sizeClass(size_t m, size_t n) {
+    size_t side = m > n ? m : n;
+    int c = 0;
+    while (((size_t)1 << c) < side) c++;
+    return c;
+}
+
+// Loads the profile of kernel on this CPU for the size class of an m x n matrix. Returns 0 if the size class was tuned,
+// 1 if the profile of the nearest tuned size class is used and -1 if the kernel was never tuned (default profile).
+// Profiles appended later override the previous ones.
+int loadProfile(const char* kernel, size_t m, size_t n, struct Profile* profile) {
+    char model[64], line[256], cpu[64], name[64];
+    int target = sizeClass(m, n), best = -1, c;
+    struct Profile p;
+
+    *profile = defaultProfile();
+    cpuModel(model, sizeof(model));
+
+    FILE* f = fopen(FILE_NAME_PROFILE, "r");
+    if (f == NULL) return -1;
+
+    while (fgets(line, sizeof(line), f) != NULL) {
+        if (sscanf(line, "%63[^,],%63[^,],%d,%zu,%d,%d,%d,%d", cpu, name, &c, &p.block, &p.order, &p.prefetch, &p.schedule, &p.chunk) != 8) continue;
+        if (strcmp(cpu, model) != 0 || strcmp(name, kernel) != 0) continue;
+        if (best == -1 || abs(c - target) <= abs(best - target)) {
+            best = c;
+            *profile = p;
+        }
+    }
+    fclose(f);
+
+    return best == -1 ? -1 : best != target;
+}
+
+int saveProfile(const char* kernel, size_t m, size_t n, const struct Profile* profile) {
+    char model[64];
+    cpuModel(model, sizeof(model));
+
+    FILE* f = fopen(FILE_NAME_PROFILE, "a");
+
+    if (f == NULL) return -1;
+
+    if (ftell(f) == 0) fprintf(f, "cpu,kernel,class,block,order,prefetch,schedule,chunk\n");
+    fprintf(f, "%s,%s,%d,%zu,%d,%d,%d,%d\n", model, kernel, sizeClass(m, n), profile->block, profile->order, profile->prefetch, profile->schedule, profile->chunk);
+    fclose(f);
+
+    return 0;
+}
+
+void printProfile(const char* kernel, const struct Profile* profile, int loaded) {
+    const char* schedules[] = {"-", "static", "dynamic", "guided"};
+    printf("%s profile (%s): block %zu, %s order, prefetch %d, schedule %s, chunk %d\n", kernel, loaded == 0 ? "tuned" : loaded == 1 ? "nearest size class" : "default",
+           profile->block, profile->order == ROW_ORDER ? "row" : "column", profile->prefetch, schedules[profile->schedule & 3], profile->chunk);
+}
+
+// Prefetches the lines of the block of side size at address block, which can lie outside of the matrix
+static inline void prefetchBlock(const double* block, size_t ld, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+        for (size_t j = 0; j < size; j += 8) {  // 8 doubles per cache line
+            _mm_prefetch((const char*)(block + i * ld + j), _MM_HINT_NTA);
+        }
+    }
+}
+
+// Checks the pair of blocks (rb, cb) and (cb, rb) of the square matrix M with the loop order and prefetch of the profile
+static inline bool checkBlockTuned(const double* M, size_t n, size_t rb, size_t cb, size_t size, const struct Profile* p) {
+    const size_t rows = blockLength(n, rb, size);    // edge blocks can be smaller
+    const size_t cols = blockLength(n, cb, size);
+    const double* first = M + (rb * n + cb) * size;  // block matrix of lower triangular part
+    const double* last = M + (cb * n + rb) * size;   // block matrix of higher triangular part
+    bool check = true;
+
+    if (p->prefetch > 0) {  // blocks checked after prefetch iterations of the column blocks loop
+        prefetchBlock(first + p->prefetch * size, n, size);
+        prefetchBlock(last + p->prefetch * size * n, n, size);
+    }
+
+    if (p->order == ROW_ORDER) {
+        for (size_t i = 0; i < rows; i++) {
+            for (size_t j = 0; j < cols; j++) {
+                if (fabs(first[i * n + j] - last[j * n + i]) > EPSILON) check = false;
+            }
+        }
+    } else {
+        for (size_t j = 0; j < cols; j++) {
+            for (size_t i = 0; i < rows; i++) {
+                if (fabs(first[i * n + j] - last[j * n + i]) > EPSILON) check = false;
+            }
+        }
+    }
+
+    return check;
+}
+
+// Transposes the block (rb, cb) of M (m x n) into T (n x m) with the loop order and prefetch of the profile
+static inline void transposeBlockTuned(const double* M, double* T, size_t m, size_t n, size_t rb, size_t cb, size_t size, const struct Profile* p) {
+    const size_t rows = blockLength(m, rb, size);    // edge blocks can be smaller
+    const size_t cols = blockLength(n, cb, size);
+    const double* source = M + (rb * n + cb) * size;
+    double* destination = T + (cb * m + rb) * size;
+
+    if (p->prefetch > 0) prefetchBlock(source + p->prefetch * size, n, size);
+
+    if (p->order == ROW_ORDER) {
+        for (size_t i = 0; i < rows; i++) {
+            for (size_t j = 0; j < cols; j++) {
+                destination[j * m + i] = source[i * n + j];
+            }
+        }
+    } else {
+        for (size_t j = 0; j < cols; j++) {
+            for (size_t i = 0; i < rows; i++) {
+                destination[j * m + i] = source[i * n + j];
+            }
+        }
+    }
+}
+
+bool checkSymTuned(const double* M, size_t m, size_t n, const struct Profile* p) {
+    if (m != n) return false;  // only square matrices can be symmetric
+    const size_t size = p->block < n ? p->block : n;
+    const size_t blocks = blockCount(n, size);
+    bool check = true;
+
+    for (size_t rb = 0; rb < blocks; rb++) {   // row blocks indexing
+        for (size_t cb = 0; cb <= rb; cb++) {  // column blocks indexing
+            check &= checkBlockTuned(M, n, rb, cb, size, p);
+        }
+    }
+
+    return check;
+}
+
+void matTransposeTuned(const double* M, double* T, size_t m, size_t n, const struct Profile* p) {
+    const size_t size = p->block < n ? p->block : n;
+    const size_t row_blocks = blockCount(m, size);
+    const size_t col_blocks = blockCount(n, size);
+
+    for (size_t rb = 0; rb < row_blocks; rb++) {      // row blocks indexing
+        for (size_t cb = 0; cb < col_blocks; cb++) {  // column blocks indexing
+            transposeBlockTuned(M, T, m, n, rb, cb, size, p);
+        }
+    }
+}
+
+#ifdef _OPENMP
+// The schedule of the profile is applied through schedule(runtime)
+bool checkSymTunedOMP(const double* M, size_t m, size_t n, const struct Profile* p) {
+    if (m != n) return false;  // only square matrices can be symmetric
+    const size_t size = p->block < n ? p->block : n;
+    const size_t blocks = blockCount(n, size);
+    bool check = true;
+
+    omp_set_schedule((omp_sched_t)p->schedule, p->chunk);
+#pragma omp parallel for schedule(runtime) reduction(&& : check)
+    for (size_t rb = 0; rb < blocks; rb++) {   // row blocks indexing
+        for (size_t cb = 0; cb <= rb; cb++) {  // column blocks indexing
+            check &= checkBlockTuned(M, n, rb, cb, size, p);
+        }
+    }
+
+    return check;
+}
+
+void matTransposeTunedOMP(const double* M, double* T, size_t m, size_t n, const struct Profile* p) {
+    const size_t size = p->block < n ? p->block : n;
+    const size_t row_blocks = blockCount(m, size);
+    const size_t col_blocks = blockCount(n, size);
+
+    omp_set_schedule((omp_sched_t)p->schedule, p->chunk);
+#pragma omp parallel for collapse(2) schedule(runtime)
+    for (size_t rb = 0; rb < row_blocks; rb++) {      // row blocks indexing
+        for (size_t cb = 0; cb < col_blocks; cb++) {  // column blocks indexing
+            transposeBlockTuned(M, T, m, n, rb, cb, size, p);
+        }
+    }
+}
+#endif
+
+#endif
\ No newline at end of file
@@ -0,0 +1,510 @@
+#ifndef TYPES_H
+#define TYPES_H
+
+#include <complex.h>
+#include <stdint.h>
+
+#include "simd.h"
+
+// Kernels generic over the element type of the matrices: float, double, int32_t, int64_t, complex double and the
+// 16-bit floating point formats. Every type gets its instantiation of the blocked kernels from DEFINE_KERNELS
+// (checkSym_f32, matTranspose_f32, ...) and the macros at the end of the file select it with _Generic.
+
+#define TYPES_BLOCK 32
+
+// Half precision (IEEE binary16) and bfloat16 are stored as their bits, since gcc 9 has no arithmetic type for them,
+// and converted to float to be compared. They are distinct structs so that _Generic can tell them apart.
+typedef struct {
+    uint16_t bits;
+} half;
+
+typedef struct {
+    uint16_t bits;
+} bfloat16;
+
+float halfToFloat(half h) {
+    const int exponent = (h.bits >> 10) & 0x1f;
+    const int mantissa = h.bits & 0x3ff;
+    float value;
+
+    if (exponent == 0) value = ldexpf(mantissa, -24);  // zero and subnormals
+    else if (exponent == 31) value = mantissa != 0 ? NAN : INFINITY;
+    else value = ldexpf(mantissa | 0x400, exponent - 25);
+
+    return h.bits & 0x8000 ? -value : value;
+}
+
+// Rounds to the nearest half, values below the normal range are flushed to zero and the ones above it to infinity
+half floatToHalf(float f) {
+    uint32_t u;
+    memcpy(&u, &f, sizeof(u));
+    const uint16_t sign = (u >> 16) & 0x8000;
+    const int exponent = (int)((u >> 23) & 0xff) - 127 + 15;
+    const uint32_t mantissa = u & 0x7fffff;
+    half h;
+
+    if (exponent >= 31) h.bits = sign | 0x7c00;
+    else if (exponent <= 0) h.bits = sign;
+    else h.bits = sign | (((exponent << 10) | (mantissa >> 13)) + ((mantissa >> 12) & 1));  // the carry can round up the exponent
+
+    return h;
+}
+
+float bfloat16ToFloat(bfloat16 b) {
+    const uint32_t u = (uint32_t)b.bits << 16;
+    float f;
+    memcpy(&f, &u, sizeof(f));
+    return f;
+}
+
+// Rounds to the nearest bfloat16, ties to even (NaN are not preserved)
+bfloat16 floatToBfloat16(float f) {
+    uint32_t u;
+    memcpy(&u, &f, sizeof(u));
+    bfloat16 b;
+    b.bits = (u + 0x7fff + ((u >> 16) & 1)) >> 16;
+    return b;
+}
+
+// Register tiles transposed by moving bits, so they only depend on the size of the elements: 8x8 tiles of 64-bit
+// elements with AVX-512 (4x4 with AVX2) from simd.h, 8x8 tiles of 32-bit elements with AVX2 (8 floats per register)
+// and 8x8 tiles of 16-bit elements with SSE2. The strides are in elements, width 1 means no SIMD support.
+#define TILE64_WIDTH SIMD_WIDTH
+
+static inline void transposeTile64(const void* source, size_t ld_source, void* destination, size_t ld_destination) {
+#if SIMD_WIDTH > 1
+    transposeTile((const double*)source, ld_source, (double*)destination, ld_destination);
+#else
+    (void)source, (void)ld_source, (void)destination, (void)ld_destination;
+#endif
+}
+
+#if defined(__AVX2__)
+#define TILE32_WIDTH 8
+#else
+#define TILE32_WIDTH 1
+#endif
+
+#if defined(__AVX2__)
+// Transposes in registers the 8x8 tile of 32-bit elements held in r[0..7] (one row per register)
+static inline void transposeRegisters32(__m256* r) {
+    __m256 t[8];
+
+    for (int i = 0; i < 8; i += 2) {  // pairs of rows interleaved
+        t[i] = _mm256_unpacklo_ps(r[i], r[i + 1]);
+        t[i + 1] = _mm256_unpackhi_ps(r[i], r[i + 1]);
+    }
+    for (int i = 0; i < 8; i += 4) {  // quadruples of rows in the 128-bit lanes
+        r[i] = _mm256_shuffle_ps(t[i], t[i + 2], _MM_SHUFFLE(1, 0, 1, 0));
+        r[i + 1] = _mm256_shuffle_ps(t[i], t[i + 2], _MM_SHUFFLE(3, 2, 3, 2));
+        r[i + 2] = _mm256_shuffle_ps(t[i + 1], t[i + 3], _MM_SHUFFLE(1, 0, 1, 0));
+        r[i + 3] = _mm256_shuffle_ps(t[i + 1], t[i + 3], _MM_SHUFFLE(3, 2, 3, 2));
+    }
+    for (int i = 0; i < 4; i++) {  // lanes of the two halves of the tile
+        t[i] = _mm256_permute2f128_ps(r[i], r[i + 4], 0x20);
+        t[i + 4] = _mm256_permute2f128_ps(r[i], r[i + 4], 0x31);
+    }
+    for (int i = 0; i < 8; i++) r[i] = t[i];
+}
+#endif
+
+static inline void transposeTile32(const void* source, size_t ld_source, void* destination, size_t ld_destination) {
+#if defined(__AVX2__)
+    const float* s = (const float*)source;
+    float* d = (float*)destination;
+    __m256 r[8];
+
+    for (int i = 0; i < 8; i++) r[i] = _mm256_loadu_ps(s + i * ld_source);
+    transposeRegisters32(r);
+    for (int i = 0; i < 8; i++) _mm256_storeu_ps(d + i * ld_destination, r[i]);
+#else
+    (void)source, (void)ld_source, (void)destination, (void)ld_destination;
+#endif
+}
+
+#define TILE16_WIDTH 8
+
+// Transposes in registers the 8x8 tile of 16-bit elements held in r[0..7] (one row per register)
+static inline void transposeRegisters16(__m128i* r) {
+    __m128i t[8];
+
+    for (int i = 0; i < 8; i += 2) {  // pairs of rows interleaved
+        t[i] = _mm_unpacklo_epi16(r[i], r[i + 1]);
+        t[i + 1] = _mm_unpackhi_epi16(r[i], r[i + 1]);
+    }
+    for (int i = 0; i < 8; i += 4) {  // quadruples of rows
+        r[i] = _mm_unpacklo_epi32(t[i], t[i + 2]);
+        r[i + 1] = _mm_unpackhi_epi32(t[i], t[i + 2]);
+        r[i + 2] = _mm_unpacklo_epi32(t[i + 1], t[i + 3]);
+        r[i + 3] = _mm_unpackhi_epi32(t[i + 1], t[i + 3]);
+    }
+    for (int i = 0; i < 4; i++) {  // halves of the tile
+        t[2 * i] = _mm_unpacklo_epi64(r[i], r[i + 4]);
+        t[2 * i + 1] = _mm_unpackhi_epi64(r[i], r[i + 4]);
+    }
+    for (int i = 0; i < 8; i++) r[i] = t[i];
+}
+
+static inline void transposeTile16(const void* source, size_t ld_source, void* destination, size_t ld_destination) {
+    const uint16_t* s = (const uint16_t*)source;
+    uint16_t* d = (uint16_t*)destination;
+    __m128i r[8];
+
+    for (int i = 0; i < 8; i++) r[i] = _mm_loadu_si128((const __m128i*)(s + i * ld_source));
+    transposeRegisters16(r);
+    for (int i = 0; i < 8; i++) _mm_storeu_si128((__m128i*)(d + i * ld_destination), r[i]);
+}
+
+// Complex elements are 16 bytes, a whole SSE register: they are moved one by one
+#define TILE0_WIDTH 1
+
+static inline void transposeTile0(const void* source, size_t ld_source, void* destination, size_t ld_destination) {
+    (void)source, (void)ld_source, (void)destination, (void)ld_destination;
+}
+
+// Comparisons of the mirrored elements a = M[i][j] and b = M[j][i], true when they differ. Floating point types are
+// compared within EPSILON, which the narrower ones widen to one unit in the last place (the rounding of the near
+// symmetric workload class), integers exactly (so the near class can be rejected) and complex matrices by real and
+// imaginary parts, also as Hermitian (a == conj(b), so the diagonal must be real).
+#define DIFFERENT_F64(a, b) (fabs((a) - (b)) > EPSILON)
+#define DIFFERENT_F32(a, b) (fabsf((a) - (b)) > fmaxf(EPSILON, FLT_EPSILON * fabsf(a)))
+#define DIFFERENT_F16(a, b) (fabsf(halfToFloat(a) - halfToFloat(b)) > fmaxf(EPSILON, 0x1.0p-10f * fabsf(halfToFloat(a))))
+#define DIFFERENT_BF16(a, b) (fabsf(bfloat16ToFloat(a) - bfloat16ToFloat(b)) > fmaxf(EPSILON, 0x1.0p-7f * fabsf(bfloat16ToFloat(a))))
+#define DIFFERENT_INT(a, b) ((a) != (b))
+#define DIFFERENT_C128(a, b) (fabs(creal(a) - creal(b)) > EPSILON || fabs(cimag(a) - cimag(b)) > EPSILON)
+#define DIFFERENT_HERMITIAN(a, b) (fabs(creal(a) - creal(b)) > EPSILON || fabs(cimag(a) + cimag(b)) > EPSILON)
+
+// Register tiles compared with the in-register transpose of their mirror tiles, like compareTile of simd.h for
+// doubles: compareTileT(first, last, n, diagonal) is non zero if an element of the tile at first differs (as DIFFERENT_T)
+// from the mirrored element of the tile at last, only in the strictly lower part of the tile when diagonal. The
+// 32-bit types compare 8x8 tiles with AVX2, half precision and bfloat16 8x8 tiles converted to 8 floats per register
+// (half precision with F16C), the 64-bit types the tiles of simd.h. Width 1 means that the type is compared element by
+// element, like the complex types.
+#if defined(__AVX2__)
+#define COMPARE32_WIDTH 8
+#else
+#define COMPARE32_WIDTH 1
+#endif
+
+#if defined(__AVX2__) && defined(__F16C__)
+#define COMPARE_F16_WIDTH 8
+#else
+#define COMPARE_F16_WIDTH 1
+#endif
+
+#define COMPARE64_WIDTH SIMD_WIDTH
+#define COMPARE0_WIDTH 1
+
+#if defined(__AVX2__)
+// Lanes of row i of a tile compared: all of them, or the strictly lower part of a diagonal tile
+#define TILE_LANES(i, diagonal) ((diagonal) ? (1 << (i)) - 1 : 0xFF)
+
+// Differences of the rows a and b of floats greater than max(EPSILON, ulp * |a|), as a mask of lanes
+static inline int differentRows(__m256 a, __m256 b, float ulp) {
+    const __m256 sign = _mm256_set1_ps(-0.0f);
+    const __m256 abs_a = _mm256_andnot_ps(sign, a);
+    const __m256 tolerance = _mm256_max_ps(_mm256_set1_ps(EPSILON), _mm256_mul_ps(_mm256_set1_ps(ulp), abs_a));
+    const __m256 abs_diff = _mm256_andnot_ps(sign, _mm256_sub_ps(a, b));
+    return _mm256_movemask_ps(_mm256_cmp_ps(abs_diff, tolerance, _CMP_GT_OQ));
+}
+
+// Loads the 8x8 tile at last (row stride n) and transposes it in registers
+static inline void loadMirror32(const void* last, size_t n, __m256* r) {
+    for (int i = 0; i < 8; i++) r[i] = _mm256_loadu_ps((const float*)last + i * n);
+    transposeRegisters32(r);
+}
+
+static inline void loadMirror16(const void* last, size_t n, __m128i* r) {
+    for (int i = 0; i < 8; i++) r[i] = _mm_loadu_si128((const __m128i*)((const uint16_t*)last + i * n));
+    transposeRegisters16(r);
+}
+
+// bfloat16 are the upper halves of floats
+static inline __m256 bfloat16Row(__m128i x) {
+    return _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_cvtepu16_epi32(x), 16));
+}
+#endif
+
+static inline int compareTileF32(const void* first, const void* last, size_t n, bool diagonal) {
+    int mismatch = 0;
+#if defined(__AVX2__)
+    __m256 r[8];
+    loadMirror32(last, n, r);
+    for (int i = 0; i < 8; i++) {
+        mismatch |= differentRows(_mm256_loadu_ps((const float*)first + i * n), r[i], FLT_EPSILON) & TILE_LANES(i, diagonal);
+    }
+#else
+    (void)first, (void)last, (void)n, (void)diagonal;
+#endif
+    return mismatch;
+}
+
+static inline int compareTileI32(const void* first, const void* last, size_t n, bool diagonal) {
+    int mismatch = 0;
+#if defined(__AVX2__)
+    __m256 r[8];
+    loadMirror32(last, n, r);  // the shuffles move the bits of the integers unchanged
+    for (int i = 0; i < 8; i++) {
+        const __m256i equal = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*)((const int32_t*)first + i * n)), _mm256_castps_si256(r[i]));
+        mismatch |= ~_mm256_movemask_ps(_mm256_castsi256_ps(equal)) & TILE_LANES(i, diagonal);
+    }
+#else
+    (void)first, (void)last, (void)n, (void)diagonal;
+#endif
+    return mismatch;
+}
+
+static inline int compareTileF16(const void* first, const void* last, size_t n, bool diagonal) {
+    int mismatch = 0;
+#if defined(__AVX2__) && defined(__F16C__)
+    __m128i r[8];
+    loadMirror16(last, n, r);
+    for (int i = 0; i < 8; i++) {
+        const __m128i a = _mm_loadu_si128((const __m128i*)((const uint16_t*)first + i * n));
+        mismatch |= differentRows(_mm256_cvtph_ps(a), _mm256_cvtph_ps(r[i]), 0x1.0p-10f) & TILE_LANES(i, diagonal);
+    }
+#else
+    (void)first, (void)last, (void)n, (void)diagonal;
+#endif
+    return mismatch;
+}
+
+static inline int compareTileBF16(const void* first, const void* last, size_t n, bool diagonal) {
+    int mismatch = 0;
+#if defined(__AVX2__)
+    __m128i r[8];
+    loadMirror16(last, n, r);
+    for (int i = 0; i < 8; i++) {
+        const __m128i a = _mm_loadu_si128((const __m128i*)((const uint16_t*)first + i * n));
+        mismatch |= differentRows(bfloat16Row(a), bfloat16Row(r[i]), 0x1.0p-7f) & TILE_LANES(i, diagonal);
+    }
+#else
+    (void)first, (void)last, (void)n, (void)diagonal;
+#endif
+    return mismatch;
+}
+
+// Doubles are compared by compareTile of simd.h, with the lanes of tileLanes
+static inline int compareTileF64(const void* first, const void* last, size_t n, bool diagonal) {
+#if SIMD_WIDTH > 1
+#if defined(__AVX512F__)
+    __mmask8 full[SIMD_WIDTH], lower[SIMD_WIDTH];
+#else
+    __m256d full[SIMD_WIDTH], lower[SIMD_WIDTH];
+#endif
+    tileLanes(full, lower);
+    return compareTile((const double*)first, (const double*)last, n, diagonal ? lower : full);
+#else
+    (void)first, (void)last, (void)n, (void)diagonal;
+    return 0;
+#endif
+}
+
+// 64-bit integers are moved by the register transpose of simd.h, which only shuffles their bits, and compared exactly
+static inline int compareTileI64(const void* first, const void* last, size_t n, bool diagonal) {
+    int mismatch = 0;
+#if defined(__AVX512F__)
+    __m512d r[8];
+    for (int i = 0; i < 8; i++) r[i] = _mm512_loadu_pd((const double*)last + i * n);
+    transposeRegisters(r);
+    for (int i = 0; i < 8; i++) {
+        const __m512i a = _mm512_loadu_si512((const int64_t*)first + i * n);
+        mismatch |= _mm512_cmpneq_epi64_mask(a, _mm512_castpd_si512(r[i])) & TILE_LANES(i, diagonal);
+    }
+#elif defined(__AVX2__)
+    __m256d r[4];
+    for (int i = 0; i < 4; i++) r[i] = _mm256_loadu_pd((const double*)last + i * n);
+    transposeRegisters(r);
+    for (int i = 0; i < 4; i++) {
+        const __m256i equal = _mm256_cmpeq_epi64(_mm256_loadu_si256((const __m256i*)((const int64_t*)first + i * n)), _mm256_castpd_si256(r[i]));
+        mismatch |= ~_mm256_movemask_pd(_mm256_castsi256_pd(equal)) & 0xF & TILE_LANES(i, diagonal);  // 4 lanes
+    }
+#else
+    (void)first, (void)last, (void)n, (void)diagonal;
+#endif
+    return mismatch;
+}
+
+static inline int compareTile0(const void* first, const void* last, size_t n, bool diagonal) {
+    (void)first, (void)last, (void)n, (void)diagonal;
+    return 0;
+}
+
+// Element written in T for the element x of M: itself, or its conjugate for the conjugate transpose
+#define SAME(x) (x)
+#define CONJUGATE(x) conj(x)
+
+// Element of type for the value v of the workload at (i, j). Integers keep three decimal digits, complex matrices get
+// an imaginary part with opposite signs in the mirrored elements and zero on the diagonal, so that the symmetric
+// workload classes are Hermitian
+#define FROM_F64(v, i, j) (v)
+#define FROM_F32(v, i, j) ((float)(v))
+#define FROM_F16(v, i, j) floatToHalf((float)(v))
+#define FROM_BF16(v, i, j) floatToBfloat16((float)(v))
+#define FROM_I32(v, i, j) ((int32_t)((v) * 1000))
+#define FROM_I64(v, i, j) ((int64_t)((v) * 1000))
+#define FROM_C128(v, i, j) ((v) + imaginaryValue(&workload, i, j) * I)
+
+double imaginaryValue(const struct Workload* w, size_t i, size_t j) {
+    if (w->kind == WORKLOAD_RANDOM) return counterRandom(w->seed, i, j, 3) * 100;
+    if (i == j) return 0;
+    return (i > j ? 1 : -1) * counterRandom(w->seed, i > j ? i : j, i > j ? j : i, 3) * 100;
+}
+
+// Instantiates for one element type:
+// - checkSym_name and checkSymOMP_name: blocked symmetry check (lower triangular blocks against their mirrors) with
+//   the compare register tiles of the type, where the diagonal is also compared so that Hermitian matrices must have a
+//   real one;
+// - matTranspose_name and matTransposeOMP_name: blocked transpose with the register tiles of the element size;
+// - initMatrices_name: allocation and generation of M (with the workload class) and T;
+// - isTransposed_name: blocked comparison of T with the transpose of M, bit by bit.
+// The OpenMP kernels use the static schedules of OB and run sequentially when compiled without -fopenmp.
+#define DEFINE_KERNELS(name, type, different, transposed, from, tile, width, compare, compare_width)                            \
+    static inline bool checkBlock_##name(const type* M, size_t n, size_t rb, size_t cb) {                                       \
+        const size_t rows = blockLength(n, rb, TYPES_BLOCK);                                                                    \
+        const size_t cols = blockLength(n, cb, TYPES_BLOCK);                                                                    \
+        const type* first = M + (rb * n + cb) * TYPES_BLOCK;                                                                    \
+        const type* last = M + (cb * n + rb) * TYPES_BLOCK;                                                                     \
+        const bool diagonal = rb == cb;                                                                                         \
+        const size_t tiled_rows = compare_width > 1 ? rows - rows % compare_width : 0;                                          \
+        const size_t tiled_cols = compare_width > 1 ? cols - cols % compare_width : 0;                                          \
+        int mismatch = 0;                                                                                                       \
+        for (size_t i = 0; i < tiled_rows; i += compare_width) {                                                                \
+            for (size_t j = 0; j < (diagonal ? i : tiled_cols); j += compare_width) {                                           \
+                mismatch |= compare(first + i * n + j, last + j * n + i, n, false);                                             \
+            }                                                                                                                   \
+            if (diagonal) mismatch |= compare(first + i * n + i, last + i * n + i, n, true);                                    \
+        }                                                                                                                       \
+        for (size_t i = 0; i < rows; i++) { /* elements outside of the tiles, with the diagonal */                              \
+            for (size_t j = i < tiled_rows ? tiled_cols : 0; j < (diagonal ? i + 1 : cols); j++) {                              \
+                if (different(first[i * n + j], last[j * n + i])) mismatch = 1;                                                 \
+            }                                                                                                                   \
+        }                                                                                                                       \
+        return mismatch == 0;                                                                                                   \
+    }                                                                                                                           \
+                                                                                                                                \
+    static inline void transposeBlock_##name(const type* M, type* T, size_t m, size_t n, size_t rb, size_t cb) {                \
+        const size_t rows = blockLength(m, rb, TYPES_BLOCK);                                                                    \
+        const size_t cols = blockLength(n, cb, TYPES_BLOCK);                                                                    \
+        const type* source = M + (rb * n + cb) * TYPES_BLOCK;                                                                   \
+        type* destination = T + (cb * m + rb) * TYPES_BLOCK;                                                                    \
+        const size_t tiled_rows = width > 1 ? rows - rows % width : 0;                                                          \
+        const size_t tiled_cols = width > 1 ? cols - cols % width : 0;                                                          \
+        for (size_t i = 0; i < tiled_rows; i += width) {                                                                        \
+            for (size_t j = 0; j < tiled_cols; j += width) {                                                                    \
+                tile(source + i * n + j, n, destination + j * m + i, m);                                                        \
+            }                                                                                                                   \
+        }                                                                                                                       \
+        for (size_t i = 0; i < rows; i++) { /* elements outside of the tiles */                                                 \
+            for (size_t j = i < tiled_rows ? tiled_cols : 0; j < cols; j++) {                                                   \
+                destination[j * m + i] = transposed(source[i * n + j]);                                                         \
+            }                                                                                                                   \
+        }                                                                                                                       \
+    }                                                                                                                           \
+                                                                                                                                \
+    bool checkSym_##name(const type* M, size_t m, size_t n) {                                                                   \
+        if (m != n) return false; /* only square matrices can be symmetric */                                                   \
+        const size_t blocks = blockCount(n, TYPES_BLOCK);                                                                       \
+        bool check = true;                                                                                                      \
+        for (size_t rb = 0; rb < blocks; rb++) {                                                                                \
+            for (size_t cb = 0; cb <= rb; cb++) check &= checkBlock_##name(M, n, rb, cb);                                       \
+        }                                                                                                                       \
+        return check;                                                                                                           \
+    }                                                                                                                           \
+                                                                                                                                \
+    void matTranspose_##name(const type* M, type* T, size_t m, size_t n) {                                                      \
+        for (size_t rb = 0; rb < blockCount(m, TYPES_BLOCK); rb++) {                                                            \
+            for (size_t cb = 0; cb < blockCount(n, TYPES_BLOCK); cb++) transposeBlock_##name(M, T, m, n, rb, cb);               \
+        }                                                                                                                       \
+    }                                                                                                                           \
+                                                                                                                                \
+    bool checkSymOMP_##name(const type* M, size_t m, size_t n) {                                                                \
+        if (m != n) return false; /* only square matrices can be symmetric */                                                   \
+        const size_t blocks = blockCount(n, TYPES_BLOCK);                                                                       \
+        bool check = true;                                                                                                      \
+        OMP_PRAGMA(omp parallel for schedule(static) reduction(&& : check))                                                     \
+        for (size_t rb = 0; rb < blocks; rb++) {                                                                                \
+            for (size_t cb = 0; cb <= rb; cb++) check &= checkBlock_##name(M, n, rb, cb);                                       \
+        }                                                                                                                       \
+        return check;                                                                                                           \
+    }                                                                                                                           \
+                                                                                                                                \
+    void matTransposeOMP_##name(const type* M, type* T, size_t m, size_t n) {                                                   \
+        const size_t row_blocks = blockCount(m, TYPES_BLOCK);                                                                   \
+        const size_t col_blocks = blockCount(n, TYPES_BLOCK);                                                                   \
+        OMP_PRAGMA(omp parallel for collapse(2) schedule(static))                                                               \
+        for (size_t rb = 0; rb < row_blocks; rb++) {                                                                            \
+            for (size_t cb = 0; cb < col_blocks; cb++) transposeBlock_##name(M, T, m, n, rb, cb);                               \
+        }                                                                                                                       \
+    }                                                                                                                           \
+                                                                                                                                \
+    int initMatrices_##name(type** M, type** T, size_t m, size_t n) {                                                           \
+        *M = (type*)allocElements(m * n, sizeof(type));                                                                         \
+        *T = (type*)allocElements(m * n, sizeof(type));                                                                         \
+        if (*M == NULL || *T == NULL) {                                                                                         \
+            free(*M);                                                                                                           \
+            free(*T);                                                                                                           \
+            return -1;                                                                                                          \
+        }                                                                                                                       \
+        OMP_PRAGMA(omp parallel for schedule(static))                                                                           \
+        for (size_t i = 0; i < m; i++) {                                                                                        \
+            for (size_t j = 0; j < n; j++) (*M)[i * n + j] = from(workloadValue(&workload, i, j), i, j);                        \
+        }                                                                                                                       \
+        for (size_t p = 0; workload.kind == WORKLOAD_PERTURBED && m > 1 && p < workload.perturbations; p++) {                   \
+            size_t i, j;                                                                                                        \
+            perturbationPosition(&workload, p, m, n, &i, &j);                                                                   \
+            (*M)[i * n + j] = from(workloadValue(&workload, i, j) + 1, i, j);                                                   \
+        }                                                                                                                       \
+        OMP_PRAGMA(omp parallel for schedule(static))                                                                           \
+        for (size_t j = 0; j < n; j++) memset(*T + j * m, 0, m * sizeof(type)); /* first touch of T */                          \
+        return 0;                                                                                                               \
+    }                                                                                                                           \
+                                                                                                                                \
+    bool isTransposed_##name(const type* M, const type* T, size_t m, size_t n) {                                                \
+        bool equal = true;                                                                                                      \
+        OMP_PRAGMA(omp parallel for schedule(static) reduction(&& : equal))                                                     \
+        for (size_t rb = 0; rb < blockCount(m, TYPES_BLOCK); rb++) {                                                            \
+            for (size_t cb = 0; cb < blockCount(n, TYPES_BLOCK) && equal; cb++) {                                               \
+                for (size_t i = rb * TYPES_BLOCK; i < rb * TYPES_BLOCK + blockLength(m, rb, TYPES_BLOCK); i++) {                \
+                    for (size_t j = cb * TYPES_BLOCK; j < cb * TYPES_BLOCK + blockLength(n, cb, TYPES_BLOCK); j++) {            \
+                        const type expected = transposed(M[i * n + j]);                                                         \
+                        if (memcmp(&T[j * m + i], &expected, sizeof(type)) != 0) equal = false;                                 \
+                    }                                                                                                           \
+                }                                                                                                               \
+            }                                                                                                                   \
+        }                                                                                                                       \
+        return equal;                                                                                                           \
+    }
+
+DEFINE_KERNELS(f16, half, DIFFERENT_F16, SAME, FROM_F16, transposeTile16, TILE16_WIDTH, compareTileF16, COMPARE_F16_WIDTH)
+DEFINE_KERNELS(bf16, bfloat16, DIFFERENT_BF16, SAME, FROM_BF16, transposeTile16, TILE16_WIDTH, compareTileBF16, COMPARE32_WIDTH)
+DEFINE_KERNELS(f32, float, DIFFERENT_F32, SAME, FROM_F32, transposeTile32, TILE32_WIDTH, compareTileF32, COMPARE32_WIDTH)
+DEFINE_KERNELS(f64, double, DIFFERENT_F64, SAME, FROM_F64, transposeTile64, TILE64_WIDTH, compareTileF64, COMPARE64_WIDTH)
+DEFINE_KERNELS(i32, int32_t, DIFFERENT_INT, SAME, FROM_I32, transposeTile32, TILE32_WIDTH, compareTileI32, COMPARE32_WIDTH)
+DEFINE_KERNELS(i64, int64_t, DIFFERENT_INT, SAME, FROM_I64, transposeTile64, TILE64_WIDTH, compareTileI64, COMPARE64_WIDTH)
+DEFINE_KERNELS(c128, complex double, DIFFERENT_C128, SAME, FROM_C128, transposeTile0, TILE0_WIDTH, compareTile0, COMPARE0_WIDTH)
+DEFINE_KERNELS(c128h, complex double, DIFFERENT_HERMITIAN, CONJUGATE, FROM_C128, transposeTile0, TILE0_WIDTH, compareTile0, COMPARE0_WIDTH)
+
+// Hermitian check and conjugate transpose of complex matrices
+#define checkHermitian checkSym_c128h
+#define checkHermitianOMP checkSymOMP_c128h
+#define matConjTranspose matTranspose_c128h
+#define matConjTransposeOMP matTransposeOMP_c128h
+
+// Kernels selected by the element type of M
+#define GENERIC_KERNEL(kernel, M)                          \
+    _Generic((M),                                          \
+        half*: kernel##_f16, const half*: kernel##_f16,     \
+        bfloat16*: kernel##_bf16, const bfloat16*: kernel##_bf16, \
+        float*: kernel##_f32, const float*: kernel##_f32,  \
+        double*: kernel##_f64, const double*: kernel##_f64, \
+        int32_t*: kernel##_i32, const int32_t*: kernel##_i32, \
+        int64_t*: kernel##_i64, const int64_t*: kernel##_i64, \
+        complex double*: kernel##_c128, const complex double*: kernel##_c128)
+
+#define checkSymGeneric(M, m, n) GENERIC_KERNEL(checkSym, M)(M, m, n)
+#define checkSymGenericOMP(M, m, n) GENERIC_KERNEL(checkSymOMP, M)(M, m, n)
+#define matTransposeGeneric(M, T, m, n) GENERIC_KERNEL(matTranspose, M)(M, T, m, n)
+#define matTransposeGenericOMP(M, T, m, n) GENERIC_KERNEL(matTransposeOMP, M)(M, T, m, n)
+
+#endif
\ No newline at end of file
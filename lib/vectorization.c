@@ -6,59 +6,55 @@
 #include <time.h>
 
 #include "functions.h"
+#include "simd.h"
 
+#if defined(AVX512)
+#define CODE "V512"
+#else
 #define CODE "V"
+#endif
 
-bool checkSymImp(const double* M, int n) {
+#define BLOCK_SIZE 32
+
+bool checkSymImp(const double* M, size_t m, size_t n) {
+    if (m != n) return false;  // only square matrices can be symmetric
+    const size_t size = BLOCK_SIZE < n ? BLOCK_SIZE : n;
+    const size_t blocks = blockCount(n, size);
     bool check = true;
 
-    __m256d epsilon_vec = _mm256_set1_pd(EPSILON);
-    for (int i = 0; i < n; i++) {
-        for (int j = 0; j < i; j += 4) {
-            __m256d row = _mm256_loadu_pd(&M[i * n + j]);    // load row values
-            __m256d col = _mm256_set_pd(M[(j + 3) * n + i],  // load column values
-                                        M[(j + 2) * n + i],
-                                        M[(j + 1) * n + i],
-                                        M[j * n + i]);
-            __m256d diff = _mm256_sub_pd(row, col);                                           // subtraction
-            __m256d abs_diff = _mm256_andnot_pd(_mm256_set1_pd(-0.0), diff);                  // absolute value
-            int mask = _mm256_movemask_pd(_mm256_cmp_pd(abs_diff, epsilon_vec, _CMP_LE_OQ));  // comparison with epsilon and converting in 4 bit mask
-
-            // (mask == 0b1111 = 15 if all comparisons are true)
-            if (mask != 15) {
-                check = false;
-            }
+    for (size_t rb = 0; rb < blocks; rb++) {                 // row blocks indexing
+        for (size_t cb = 0; cb <= rb; cb++) {                // column blocks indexing
+            const double* first = M + (rb * n + cb) * size;  // block matrix of lower triangular part
+            const double* last = M + (cb * n + rb) * size;   // block matrix of higher triangular part
+            check &= checkBlock(first, last, n, blockLength(n, rb, size), blockLength(n, cb, size), rb == cb);  // tile-pair comparison in registers
         }
     }
 
     return check;
 }
 
-void matTransposeImp(const double* M, double* T, int n) {
-    for (int i = 0; i < n; i++) {
-        for (int j = 0; j < n; j++) {
-            T[j * n + i] = M[i * n + j];
+void matTransposeImp(const double* M, double* T, size_t m, size_t n) {
+    const size_t size = BLOCK_SIZE < n ? BLOCK_SIZE : n;
+
+    for (size_t rb = 0; rb < blockCount(m, size); rb++) {     // row blocks indexing
+        for (size_t cb = 0; cb < blockCount(n, size); cb++) { // column blocks indexing
+            const double* source = M + (rb * n + cb) * size;  // block matrix of lower triangular part
+            double* destination = T + (cb * m + rb) * size;   // block matrix of higher triangular part
+            transposeBlock(source, n, destination, m, blockLength(m, rb, size), blockLength(n, cb, size));  // transposing with register tiles
         }
     }
 }
 
 // The attribute is necessary to avoid the compiler optimization on the repetitions loops
 int __attribute__((optimize("O0"))) main(int argc, char** argv) {
-    int dim = 0;
+    size_t m = 0;
+    size_t n = 0;
     int rep = 0;
-    if (argc < 2) {
-        printf("Correct usage: program-name [M dimension as exponent of 2] [number of repetitions (default 5)]");
+    if (parseArguments(argc, argv, &m, &n, &rep, NULL) == -1) {
         return 1;
-    } else if (argc == 2) {
-        dim = atoi(argv[1]);
-        rep = 500;
-    } else {
-        dim = atoi(argv[1]);
-        rep = atoi(argv[2]) > 0 ? atoi(argv[2]) : 500;
     }
 
-    unsigned int n = pow(2, dim);
-    printf("Matrix dimension: %d\n\n", n);
+    printf("Matrix dimensions: %zu x %zu\n\n", m, n);
     printf("Repetitions: %d\n\n", rep);
 
     // Variables declaration
@@ -69,18 +65,18 @@ int __attribute__((optimize("O0"))) main(int argc, char** argv) {
     double* T;                        // transposed matrix
 
     // Matrices allocation
-    if (initMatrices(&M, &T, n) == -1) {
+    if (initMatrices(&M, &T, m, n) == -1) {
         printf("Error in allocating matrices!\n\n");
         return -1;
     }
 
     // Execution
     clock_gettime(CLOCK_MONOTONIC, &s1);
-    for (int i = 0; i < rep; i++) symmetric = checkSymImp(M, n);
+    for (int i = 0; i < rep; i++) symmetric = checkSymImp(M, m, n);
     clock_gettime(CLOCK_MONOTONIC, &e1);
 
     clock_gettime(CLOCK_MONOTONIC, &s2);
-    for (int i = 0; i < rep; i++) matTransposeImp(M, T, n);
+    for (int i = 0; i < rep; i++) matTransposeImp(M, T, m, n);
     clock_gettime(CLOCK_MONOTONIC, &e2);
     // --------------------------------
 
@@ -88,16 +84,16 @@ int __attribute__((optimize("O0"))) main(int argc, char** argv) {
     t1 = elapsedTime(s1, e1) / rep;
     t2 = elapsedTime(s2, e2) / rep;
 
-    flops = (double)((n * n) / 2 - n) / t1;
-    bandwidth = (double)(2 * n * n * sizeof(double)) / t2;
+    flops = m == n ? ((double)n * n / 2 - n) / t1 : 0;  // rectangular matrices are not checked
+    bandwidth = (double)(2 * m * n * sizeof(double)) / t2;
 
     printf("Sequential execution: symmetry: %s\n", symmetric ? "true" : "false");
     printf("checkSym:\t%.9f seconds\t%10.4g GFLOPS\n", t1, flops * 1e-9);
     printf("matTranspose:\t%.9f seconds\t%10.4g GB/s\n\n", t2, bandwidth * 1e-9);
 
-    testResults(M, T, n);
+    testResults(M, T, m, n);
 
-    if (saveResultsILP(CODE, n, flops, bandwidth) == -1) {
+    if (saveResultsILP(CODE, m, n, flops, bandwidth) == -1) {
         printf("Error in saving results!\n\n");
     }
 
@@ -4,7 +4,8 @@ import numpy as np
 import pandas as pd
 import matplotlib.pyplot as plt
 
-n = input("Enter the value of n to plot: ")
+n = input("Enter the matrix dimensions to plot (N or ROWSxCOLUMNS): ")
+m, n = (int(x) for x in n.split("x")) if "x" in n else (int(n), int(n))
 
 # Load the data
 data = pd.read_csv("results/results_omp.csv")
@@ -13,11 +14,10 @@ data = pd.read_csv("results/results_omp.csv")
 data = data.sort_values(["code", "n"])
 
 # Filter the data
-filter = pow(2, int(n))
-data = data[data["n"] == filter]
+data = data[(data["m"] == m) & (data["n"] == n)]
 
 
-custom_code_order = ["O", "OR", "OB", "OBT", "OB_S", "OB_D", "OBf"]
+custom_code_order = ["O", "OR", "OB", "OBH", "OBT", "OB_S", "OB_D", "OBf", "OIP", "OBV", "OB_DV", "OBVS", "OCO", "OAT", "ON", "OB_F16", "OB_BF16", "OB_F32", "OB_F64", "OB_I32", "OB_I64", "OB_C128", "OBP", "OAD", "OB_B", "OB_BW"]
 xticks_values = [1, 2, 4, 8, 16, 32, 64]
 color_map = {code: plt.cm.tab10(i) for i, code in enumerate(data["code"].unique())}
 
@@ -1,30 +1,68 @@
 #!/bin/bash
 # SIMULATIONS PARAMETERS
 default_n=0
+# matrix dimensions of the sweep run when n=0, non-powers of two avoid the cache aliasing of powers of two
+sweep_n=(16 24 32 48 64 100 128 200 256 500 512 1000 1024 1500 2048 3000 4096)
 default_rep=500
 default_threads=0
+# verification of the results of every program: full, checksum (only the weighted checksums) or none
+export VERIFY="${VERIFY:-full}"
 # END OF SIMULATIONS PARAMETERS
 gcc --version
 is_integer() {
   [[ "$1" =~ ^[0-9]+$ ]]
 }
+is_dimension() {
+  [[ "$1" =~ ^[0-9]+(x[0-9]+)?$ ]]
+}
 run_simulations() {
   echo ""; echo "Executing programs..."
   echo ""; echo "sequential.o"; ./sequential.o "$n" "$rep"
   echo ""; echo "vectorization.o"; ./vectorization.o "$n" "$rep"
+  echo ""; echo "vectorization_avx512.o"; ./vectorization_avx512.o "$n" "$rep"
   echo ""; echo "block_access_pattern.o"; ./block_access_pattern.o "$n" "$rep"
   echo ""; echo "block_access_pattern_prefetching.o"; ./block_access_pattern_prefetching.o "$n" "$rep"
   echo ""; echo "block_access_pattern_O1.o"; ./block_access_pattern_O1.o "$n" "$rep"
   echo ""; echo "block_access_pattern_O2.o"; ./block_access_pattern_O2.o "$n" "$rep"
   echo ""; echo "block_access_pattern_O3.o"; ./block_access_pattern_O3.o "$n" "$rep"
   echo ""; echo "block_access_pattern_Ofast.o"; ./block_access_pattern_Ofast.o "$n" "$rep"
+  echo ""; echo "block_access_pattern_huge_pages.o"; ./block_access_pattern_huge_pages.o "$n" "$rep"
+  echo ""; echo "in_place.o"; ./in_place.o "$n" "$rep"
   echo ""; echo "omp.o"; ./omp.o "$n" "$rep" "$threads"
   echo ""; echo "omp_reduction.o"; ./omp_reduction.o "$n" "$rep" "$threads"
   echo ""; echo "omp_block_access_pattern.o"; ./omp_block_access_pattern.o "$n" "$rep" "$threads"
+  echo ""; echo "omp_block_access_pattern_huge_pages.o"; ./omp_block_access_pattern_huge_pages.o "$n" "$rep" "$threads"
   echo ""; echo "omp_triangular_numbers.o"; ./omp_triangular_numbers.o "$n" "$rep" "$threads"
   echo ""; echo "omp_static_scheduling.o"; ./omp_static_scheduling.o "$n" "$rep" "$threads"
   echo ""; echo "omp_dynamic_scheduling.o"; ./omp_dynamic_scheduling.o "$n" "$rep" "$threads"
   echo ""; echo "omp_dynamic_scheduling_Ofast.o"; ./omp_dynamic_scheduling_Ofast.o "$n" "$rep" "$threads"
+  echo ""; echo "omp_in_place.o"; ./omp_in_place.o "$n" "$rep" "$threads"
+  echo ""; echo "omp_block_access_pattern_simd.o"; ./omp_block_access_pattern_simd.o "$n" "$rep" "$threads"
+  echo ""; echo "omp_dynamic_scheduling_simd.o"; ./omp_dynamic_scheduling_simd.o "$n" "$rep" "$threads"
+  echo ""; echo "omp_block_access_pattern_stream.o"; ./omp_block_access_pattern_stream.o "$n" "$rep" "$threads"
+  echo ""; echo "early_exit.o"; ./early_exit.o "$n" "$rep"
+  echo ""; echo "omp_early_exit.o"; ./omp_early_exit.o "$n" "$rep" "$threads"
+  echo ""; echo "cache_oblivious.o"; ./cache_oblivious.o "$n" "$rep"
+  echo ""; echo "omp_cache_oblivious.o"; ./omp_cache_oblivious.o "$n" "$rep" "$threads"
+  echo ""; echo "autotune.o"; ./autotune.o "$n" "$rep" "$threads"
+  echo ""; echo "autotuned.o"; ./autotuned.o "$n" "$rep"
+  echo ""; echo "omp_autotuned.o"; ./omp_autotuned.o "$n" "$rep" "$threads"
+  echo ""; echo "omp_numa.o"; OMP_PROC_BIND=spread OMP_PLACES=cores ./omp_numa.o "$n" "$rep" "$threads"
+  echo ""; echo "element_types.o"; ./element_types.o "$n" "$rep"
+  echo ""; echo "omp_element_types.o"; ./omp_element_types.o "$n" "$rep" "$threads"
+  echo ""; echo "omp_batched.o"; ./omp_batched.o "$n" "$rep" "$threads"
+  echo ""; echo "omp_persistent.o"; ./omp_persistent.o "$n" "$rep" "$threads"
+  echo ""; echo "omp_adaptive.o"; ./omp_adaptive.o "$n" "$rep" "$threads"
+  echo ""; echo "omp_balanced.o"; ./omp_balanced.o "$n" "$rep" "$threads"
+  echo ""; echo "omp_balanced_stealing.o"; ./omp_balanced_stealing.o "$n" "$rep" "$threads"
+  echo ""; echo "omp_fused.o"; ./omp_fused.o "$n" "$rep" "$threads"
+  echo ""; echo "omp_fused_simd.o"; ./omp_fused_simd.o "$n" "$rep" "$threads"
+  echo ""; echo "omp_packed.o"; ./omp_packed.o "$n" "$rep" "$threads"
+  echo ""; echo "omp_out_of_core.o"; ./omp_out_of_core.o "$n" "$rep" "$threads"
+  echo ""; echo "omp_streaming.o"; ./omp_streaming.o "$n" "$rep" "$threads" < /dev/null
+  echo ""; echo "omp_freivalds.o"; ./omp_freivalds.o "$n" "$rep" "$threads"
+  echo ""; echo "omp_freivalds_simd.o"; ./omp_freivalds_simd.o "$n" "$rep" "$threads"
+  echo ""; echo "omp_tracked.o"; ./omp_tracked.o "$n" "$rep" "$threads"
 }
 n=""
 rep=""
@@ -34,7 +72,7 @@ if [[ $# -eq 0 ]]; then
   rep=$default_rep
   threads=$default_threads
 elif [[ $# -eq 1 ]]; then
-  if is_integer "$1" && (($1 >= 4 && $1 <= 12)); then
+  if is_dimension "$1"; then
     n="$1"
   else
     n=$default_n
@@ -42,7 +80,7 @@ elif [[ $# -eq 1 ]]; then
   rep=$default_rep
   threads=$default_threads
 elif [[ $# -eq 2 ]]; then
-  if is_integer "$1" && (($1 >= 4 && $1 <= 12)); then
+  if is_dimension "$1"; then
     n="$1"
   else
     n=$default_n
@@ -55,7 +93,7 @@ elif [[ $# -eq 2 ]]; then
   fi
   threads=$default_threads
 else 
-  if is_integer "$1" && (($1 >= 4 && $1 <= 12)); then
+  if is_dimension "$1"; then
     n="$1"
   else
     n=$default_n
@@ -82,19 +120,50 @@ echo ""
 echo "Compiling..."
 gcc sequential.c -o ../bin/sequential.o -lm
 gcc vectorization.c -o ../bin/vectorization.o -mavx2 -lm
+gcc vectorization.c -o ../bin/vectorization_avx512.o -mavx2 -mavx512f -lm -DAVX512
 gcc block_access_pattern.c -o ../bin/block_access_pattern.o -lm
 gcc block_access_pattern_prefetching.c -o ../bin/block_access_pattern_prefetching.o -lm
 gcc block_access_pattern.c -o ../bin/block_access_pattern_O1.o -O1 -lm -DO1
 gcc block_access_pattern.c -o ../bin/block_access_pattern_O2.o -O2 -lm -DO2
 gcc block_access_pattern.c -o ../bin/block_access_pattern_O3.o -O3 -lm -DO3
 gcc block_access_pattern.c -o ../bin/block_access_pattern_Ofast.o -Ofast -lm -DOfast
+gcc block_access_pattern.c -o ../bin/block_access_pattern_huge_pages.o -lm -DHUGE_PAGES -DPREFAULT
+gcc in_place.c -o ../bin/in_place.o -lm
 gcc omp.c -o ../bin/omp.o -fopenmp -lm
 gcc omp_reduction.c -o ../bin/omp_reduction.o -fopenmp -lm
 gcc omp_block_access_pattern.c -o ../bin/omp_block_access_pattern.o -fopenmp -lm
+gcc omp_block_access_pattern.c -o ../bin/omp_block_access_pattern_huge_pages.o -fopenmp -lm -DHUGE_PAGES -DPREFAULT
 gcc omp_triangular_numbers.c -o ../bin/omp_triangular_numbers.o -fopenmp -lm
 gcc omp_static_scheduling.c -o ../bin/omp_static_scheduling.o -fopenmp -lm
 gcc omp_dynamic_scheduling.c -o ../bin/omp_dynamic_scheduling.o -fopenmp -lm
 gcc omp_dynamic_scheduling.c -o ../bin/omp_dynamic_scheduling_Ofast.o -fopenmp -Ofast -lm -DOfast
+gcc omp_in_place.c -o ../bin/omp_in_place.o -fopenmp -lm
+gcc omp_block_access_pattern.c -o ../bin/omp_block_access_pattern_simd.o -fopenmp -mavx2 -lm -DSIMD
+gcc omp_dynamic_scheduling.c -o ../bin/omp_dynamic_scheduling_simd.o -fopenmp -mavx2 -lm -DSIMD
+gcc omp_block_access_pattern.c -o ../bin/omp_block_access_pattern_stream.o -fopenmp -mavx2 -lm -DSIMD -DSTREAM
+gcc early_exit.c -o ../bin/early_exit.o -mavx2 -lm
+gcc omp_early_exit.c -o ../bin/omp_early_exit.o -fopenmp -mavx2 -lm
+gcc cache_oblivious.c -o ../bin/cache_oblivious.o -lm
+gcc omp_cache_oblivious.c -o ../bin/omp_cache_oblivious.o -fopenmp -lm
+gcc autotune.c -o ../bin/autotune.o -fopenmp -lm
+gcc autotuned.c -o ../bin/autotuned.o -lm
+gcc omp_autotuned.c -o ../bin/omp_autotuned.o -fopenmp -lm
+gcc omp_numa.c -o ../bin/omp_numa.o -fopenmp -lm
+gcc element_types.c -o ../bin/element_types.o -mavx2 -mf16c -lm
+gcc omp_element_types.c -o ../bin/omp_element_types.o -fopenmp -mavx2 -mf16c -lm
+gcc omp_batched.c -o ../bin/omp_batched.o -fopenmp -mavx2 -lm
+gcc omp_persistent.c -o ../bin/omp_persistent.o -fopenmp -lm
+gcc omp_adaptive.c -o ../bin/omp_adaptive.o -fopenmp -mavx2 -lm
+gcc omp_balanced.c -o ../bin/omp_balanced.o -fopenmp -lm
+gcc omp_balanced.c -o ../bin/omp_balanced_stealing.o -fopenmp -lm -DWORK_STEALING
+gcc omp_fused.c -o ../bin/omp_fused.o -fopenmp -lm
+gcc omp_fused.c -o ../bin/omp_fused_simd.o -fopenmp -mavx2 -lm -DSIMD
+gcc omp_packed.c -o ../bin/omp_packed.o -fopenmp -lm
+gcc omp_out_of_core.c -o ../bin/omp_out_of_core.o -fopenmp -lm
+gcc omp_streaming.c -o ../bin/omp_streaming.o -fopenmp -lm
+gcc omp_freivalds.c -o ../bin/omp_freivalds.o -fopenmp -lm
+gcc omp_freivalds.c -o ../bin/omp_freivalds_simd.o -fopenmp -mavx2 -lm -DSIMD
+gcc omp_tracked.c -o ../bin/omp_tracked.o -fopenmp -lm
 echo "Compiling executed correctly!"
 cd ../bin
 echo ""; echo "Preparing results files..."
@@ -103,14 +172,50 @@ touch cpu_specs
 lscpu > cpu_specs
 rm -f results_ilp.csv
 touch results_ilp.csv
-echo "code,n,flops,bandwidth" > results_ilp.csv
+echo "code,m,n,flops,bandwidth" > results_ilp.csv
 rm -f results_omp.csv
 touch results_omp.csv
-echo "code,n,threads,speedup1,efficiency1,speedup2,efficiency2,bandwidth" > results_omp.csv
+echo "code,m,n,threads,speedup1,efficiency1,speedup2,efficiency2,bandwidth" > results_omp.csv
+rm -f results_early_exit.csv
+touch results_early_exit.csv
+echo "code,m,n,threads,full,rejection,termination" > results_early_exit.csv
+rm -f results_tlb.csv
+touch results_tlb.csv
+echo "code,m,n,threads,check,transpose" > results_tlb.csv
+rm -f results_numa.csv
+touch results_numa.csv
+echo "code,m,n,threads,est_local_check,est_remote_check,est_local_transpose,est_remote_transpose" > results_numa.csv
+rm -f results_batched.csv
+touch results_batched.csv
+echo "code,m,n,threads,count,check_batched,transpose_batched,check_single,transpose_single" > results_batched.csv
+rm -f results_fork_join.csv
+touch results_fork_join.csv
+echo "code,m,n,threads,fork_join,check,transpose" > results_fork_join.csv
+rm -f results_fused.csv
+touch results_fused.csv
+echo "code,m,n,threads,separate,fused,bandwidth_separate,bandwidth_fused" > results_fused.csv
+rm -f results_packed.csv
+touch results_packed.csv
+echo "code,m,n,threads,layout,pack_verify,pack,unpack,transpose,bandwidth_pack,bandwidth_unpack" > results_packed.csv
+rm -f results_out_of_core.csv
+touch results_out_of_core.csv
+echo "code,m,n,threads,budget,check,transpose,bandwidth_check,bandwidth_transpose,bandwidth_check_memory,bandwidth_transpose_memory" > results_out_of_core.csv
+rm -f results_streaming.csv
+touch results_streaming.csv
+echo "code,m,n,threads,buffers,matrices,time,matrices_per_second,bandwidth,read_stall,compute_stall,write_stall" > results_streaming.csv
+rm -f results_freivalds.csv
+touch results_freivalds.csv
+echo "code,m,n,threads,trials,exact,filter,filtered,bandwidth_exact,bandwidth_filter" > results_freivalds.csv
+rm -f results_tracked.csv
+touch results_tracked.csv
+echo "code,m,n,threads,updates,checked,full,update,tracked,speedup" > results_tracked.csv
+rm -f results_tracked_transpose.csv
+touch results_tracked_transpose.csv
+echo "code,m,n,threads,updates,patched,refreshed,full,refresh,speedup" > results_tracked_transpose.csv
 echo "Done!"
-if [[ $n -eq 0 ]]; then 
-  echo ""; echo "n is set to 0. Running simulations from n=4 to n=12 and rep=$rep"
-  for ((i = 4 ; i < 13 ; i++ )); do
+if [[ "$n" == "0" ]]; then 
+  echo ""; echo "n is set to 0. Running simulations for n=${sweep_n[*]} and rep=$rep"
+  for i in "${sweep_n[@]}"; do
     n=$i
     run_simulations
   done
@@ -126,7 +231,33 @@ cd results
 rm -f cpu_specs
 rm -f results_ilp.csv
 rm -f results_omp.csv
+rm -f results_early_exit.csv
+rm -f results_tlb.csv
+rm -f results_numa.csv
+rm -f results_batched.csv
+rm -f results_fork_join.csv
+rm -f results_fused.csv
+rm -f results_packed.csv
+rm -f results_out_of_core.csv
+rm -f results_streaming.csv
+rm -f results_freivalds.csv
+rm -f results_tracked.csv
+rm -f results_tracked_transpose.csv
 mv ../bin/cpu_specs ./cpu_specs
+cp ../bin/tuning_profiles.csv ./tuning_profiles.csv 2>/dev/null
+cp ../bin/dispatch_profiles.csv ./dispatch_profiles.csv 2>/dev/null
 mv ../bin/results_ilp.csv ./results_ilp.csv
 mv ../bin/results_omp.csv ./results_omp.csv
+mv ../bin/results_early_exit.csv ./results_early_exit.csv
+mv ../bin/results_tlb.csv ./results_tlb.csv
+mv ../bin/results_numa.csv ./results_numa.csv
+mv ../bin/results_batched.csv ./results_batched.csv
+mv ../bin/results_fork_join.csv ./results_fork_join.csv
+mv ../bin/results_fused.csv ./results_fused.csv
+mv ../bin/results_packed.csv ./results_packed.csv
+mv ../bin/results_out_of_core.csv ./results_out_of_core.csv
+mv ../bin/results_streaming.csv ./results_streaming.csv
+mv ../bin/results_freivalds.csv ./results_freivalds.csv
+mv ../bin/results_tracked.csv ./results_tracked.csv
+mv ../bin/results_tracked_transpose.csv ./results_tracked_transpose.csv
 echo "All done!"
\ No newline at end of file